@@ -35,6 +35,7 @@ class AlgorithmsTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testDeutsch);
   CPPUNIT_TEST(testDeutschJozsa);
   CPPUNIT_TEST(testBernsteinVazirani);
+  CPPUNIT_TEST(testBernsteinVaziraniInPlace);
   CPPUNIT_TEST(testSimon);
   CPPUNIT_TEST_SUITE_END();
 
@@ -346,6 +347,29 @@ class AlgorithmsTest : public CppUnit::TestFixture
       CPPUNIT_ASSERT( u == Gate().U(g) );
     }
 
+    void testBernsteinVaziraniInPlace()
+    {
+      // The same algorithm for 16 input qubits without any 2^n × 2^n gate.
+      const int n = 16, a = 0xb00c;
+      Gate h;
+      h.H();
+
+      std::vector<int> f(1 << n);
+      for (int i = 0; i < (1 << n); ++i) {
+        f[i] = bwise_bin_dot(i,a);
+      }
+
+      Qubit x(1,n+1);
+      for (int j = 0; j <= n; ++j) {
+        x.apply(h,j);
+      }
+      x.applyOracle(f);
+      for (int j = 0; j <= n; ++j) {
+        x.apply(h,j);
+      }
+      CPPUNIT_ASSERT( x.isApprox(Qubit(a,n).tensorDot(Qubit(1,1))) );
+    }
+
     void testSimon()
     {
       std::vector<int> f(4);
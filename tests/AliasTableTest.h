@@ -0,0 +1,137 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_ALIASTABLETEST_H
+#define QUCOSI_ALIASTABLETEST_H
+
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/AliasTable>
+#include <QuCoSi/Aux>
+
+namespace QuCoSi {
+
+class AliasTableTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(AliasTableTest);
+  CPPUNIT_TEST(testDistribution);
+  CPPUNIT_TEST(testSingleOutcome);
+  CPPUNIT_TEST(testLargeFloat);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp() {}
+
+    void tearDown() {}
+
+    // Drawing with a regular grid of random numbers reproduces the
+    // distribution up to the resolution of the grid.
+    void testDistribution()
+    {
+      std::vector<fptype> p(6);
+      p[0] = 0.5;
+      p[1] = 0.25;
+      p[2] = 0.125;
+      p[3] = 0.;
+      p[4] = 0.0625;
+      p[5] = 0.0625;
+      CPPUNIT_ASSERT( check(p) );
+
+      // Unnormalized weights are normalized.
+      for (int i = 0; i < int(p.size()); ++i) {
+        p[i] = (i*7) % 5;
+      }
+      CPPUNIT_ASSERT( check(p) );
+    }
+
+    void testSingleOutcome()
+    {
+      std::vector<fptype> p(8, 0.);
+      p[5] = 1.;
+      AliasTable t(p);
+
+      CPPUNIT_ASSERT( t.size() == 8 );
+      CPPUNIT_ASSERT( t.draw(0., 0.) == 5 );
+      CPPUNIT_ASSERT( t.draw(0.3, 0.99) == 5 );
+      CPPUNIT_ASSERT( t.draw(0.999, 0.5) == 5 );
+    }
+
+    // More than 2^24 outcomes in single precision: a float sum of the
+    // probabilities stops growing at 2^24 and a float random number only
+    // reaches every second cell.
+    void testLargeFloat()
+    {
+      const int bits = 25, n = 1 << bits;
+      std::vector<float> p(n);
+      for (int i = 0; i < n; ++i) {
+        p[i] = i % 2 ? 3.f : 1.f;
+      }
+      AliasTable t(p);
+      CPPUNIT_ASSERT( t.size() == n );
+
+      // Every cell is made up of halves of outcomes, so four draws per
+      // cell hit every even outcome twice and every odd one six times.
+      std::vector<int> counts(n, 0);
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          ++counts[t.draw(uint64_t(i) << (64-bits), (j+0.5)/4)];
+        }
+      }
+      bool exact = true;
+      for (int i = 0; i < n; ++i) {
+        exact = exact && counts[i] == (i % 2 ? 6 : 2);
+      }
+      CPPUNIT_ASSERT( exact );
+    }
+
+  private:
+    bool check(const std::vector<fptype>& p)
+    {
+      const int n = p.size(), m = 1000;
+      AliasTable t(p);
+      std::vector<int> counts(n, 0);
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+          ++counts[t.draw((i+0.5)/n, (j+0.5)/m)];
+        }
+      }
+
+      fptype sum = 0.;
+      for (int i = 0; i < n; ++i) {
+        sum += p[i];
+      }
+      for (int i = 0; i < n; ++i) {
+        if (std::abs(fptype(counts[i])/(n*m) - p[i]/sum) > 2./m) {
+          return false;
+        }
+        if (p[i] == 0 && counts[i] != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_ALIASTABLETEST_H
+
+// vim: shiftwidth=2 textwidth=78
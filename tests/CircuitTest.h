@@ -0,0 +1,203 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_CIRCUITTEST_H
+#define QUCOSI_CIRCUITTEST_H
+
+#include <cstdlib>
+#include <ctime>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Circuit>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class CircuitTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CircuitTest);
+  CPPUNIT_TEST(testToGate);
+  CPPUNIT_TEST(testRun);
+  CPPUNIT_TEST(testBernsteinVazirani);
+  CPPUNIT_TEST(testOptimize);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testToGate()
+    {
+      Gate g[9];
+
+      Circuit c(1);
+      c.H(0).X(0).H(0);
+      CPPUNIT_ASSERT( c.size() == 3 );
+      CPPUNIT_ASSERT( c.toGate().isApprox(g[0].Z()) );
+
+      Circuit d(2);
+      d.H(1).C(1,0,g[0].Z()).H(1);
+      CPPUNIT_ASSERT( d.toGate().isApprox(g[1].CNOT()) );
+
+      Circuit e(3);
+      e.CCNOT(0,1,2);
+      CPPUNIT_ASSERT( e.toGate() == g[2].CCNOT() );
+      e = Circuit(3);
+      e.CSWAP(0,1,2);
+      CPPUNIT_ASSERT( e.toGate() == g[3].CSWAP() );
+      e = Circuit(3);
+      e.SWAP(2,0);
+      CPPUNIT_ASSERT( e.toGate() == g[4].S(0,2,3) );
+
+      Circuit f(4);
+      f.Rx(0.2,0).Ry(0.3,1).Rz(0.4,2).R(5,3).P(0).T(1).Y(2).CNOT(3,1);
+      CPPUNIT_ASSERT( f.toGate().isApprox(
+        g[0].C(1,3,4,g[1].X()) *
+        g[2].Y().applyTo(2,4) * g[3].T().applyTo(1,4) *
+        g[4].P().applyTo(0,4) * g[5].R(5).applyTo(3,4) *
+        g[6].Rz(0.4).applyTo(2,4) * g[7].Ry(0.3).applyTo(1,4) *
+        g[8].Rx(0.2).applyTo(0,4)) );
+
+      Circuit q(4);
+      q.qft(1,3);
+      CPPUNIT_ASSERT( q.toGate().isApprox(g[0].F(3).applyTo(1,4)) );
+      q.inverseQft(1,3);
+      CPPUNIT_ASSERT( q.toGate().isApprox(g[0].I().tensorPow(4)) );
+    }
+
+    void testRun()
+    {
+      Qubit q(32), x, y;
+      q.randomize();
+
+      std::vector<int> f(16), t(2), cs(2), v(2);
+      for (int i = 0; i < 16; ++i) {
+        f[i] = std::rand() % 2;
+      }
+      t[0] = 4;
+      t[1] = 0;
+      cs[0] = 1;
+      cs[1] = 3;
+      v[0] = 0;
+      v[1] = 1;
+
+      Gate u;
+      Circuit c(5);
+      c.H(2).Uf(f).C(u.SWAP(),t,cs,v).CNOT(0,3).qft(0,5).T(4);
+
+      x = c*q;
+      y = c.toGate()*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      Circuit d(5);
+      d.append(c).append(c);
+      CPPUNIT_ASSERT( d.size() == 2*c.size() );
+      x = q;
+      d.run(x);
+      y = c*(c*q);
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+
+    void testBernsteinVazirani()
+    {
+      // The circuit of AlgorithmsTest::testBernsteinVazirani() for a = 25.
+      Circuit c(6);
+      for (int j = 0; j < 6; ++j) c.H(j);
+      c.CNOT(0,5).CNOT(1,5).CNOT(4,5);
+      for (int j = 0; j < 6; ++j) c.H(j);
+
+      CPPUNIT_ASSERT( (c*Qubit(1,6)).isApprox(
+        Qubit(25,5).tensorDot(Qubit(1,1))) );
+    }
+
+    void testOptimize()
+    {
+      Gate g;
+
+      // Self-inverse pairs cancel.
+      Circuit c(3);
+      c.H(0).H(0).CNOT(0,1).CNOT(0,1).SWAP(0,2).SWAP(2,0).CCNOT(0,1,2)
+       .CCNOT(1,0,2);
+      CPPUNIT_ASSERT( c.optimize() == 8 );
+      CPPUNIT_ASSERT( c.size() == 0 );
+
+      // Different controls or targets do not cancel.
+      c.CNOT(0,1).CNOT(1,0).CNOT(0,2);
+      CPPUNIT_ASSERT( c.optimize() == 0 );
+      CPPUNIT_ASSERT( c.size() == 3 );
+
+      // Single-qubit gates on a wire are fused into one gate.
+      Circuit d(2);
+      d.T(0).Rz(0.3,0).P(0).H(1);
+      Gate u = d.toGate();
+      CPPUNIT_ASSERT( d.optimize() == 2 );
+      CPPUNIT_ASSERT( d.size() == 2 );
+      CPPUNIT_ASSERT( d.toGate().isApprox(u) );
+
+      // Fused gates that are the identity vanish.
+      d = Circuit(2);
+      d.T(0).T(0).P(0).Z(0);
+      CPPUNIT_ASSERT( d.optimize() == 4 );
+
+      // Diagonal gates commute through control qubits.
+      Circuit e(3);
+      e.CNOT(0,1).T(0).Z(0).CNOT(0,1).CCNOT(0,1,2).T(0);
+      u = e.toGate();
+      CPPUNIT_ASSERT( e.optimize() == 4 );
+      CPPUNIT_ASSERT( e.size() == 2 );
+      CPPUNIT_ASSERT( e.toGate().isApprox(u) );
+
+      // But not through target qubits.
+      e = Circuit(2);
+      e.CNOT(0,1).T(1).CNOT(0,1);
+      CPPUNIT_ASSERT( e.optimize() == 0 );
+
+      // The unitary of a random circuit is preserved.
+      Circuit f(4);
+      for (int i = 0; i < 200; ++i) {
+        const int a = std::rand() % 4, b = (a + 1 + std::rand() % 3) % 4;
+        switch (std::rand() % 8) {
+          case 0: f.H(a); break;
+          case 1: f.X(a); break;
+          case 2: f.T(a); break;
+          case 3: f.Z(a); break;
+          case 4: f.CNOT(a,b); break;
+          case 5: f.SWAP(a,b); break;
+          case 6: f.Rz(0.1*i,a); break;
+          case 7: f.C(b,a,g.Z()); break;
+        }
+      }
+      u = f.toGate();
+      const int n = f.size();
+      const int removed = f.optimize();
+      CPPUNIT_ASSERT( removed > 0 );
+      CPPUNIT_ASSERT( f.size() == n - removed );
+      CPPUNIT_ASSERT( f.toGate().isApprox(u) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_CIRCUITTEST_H
+
+// vim: shiftwidth=2 textwidth=78
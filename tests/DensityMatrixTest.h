@@ -0,0 +1,191 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_DENSITYMATRIXTEST_H
+#define QUCOSI_DENSITYMATRIXTEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/DensityMatrix>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class DensityMatrixTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DensityMatrixTest);
+  CPPUNIT_TEST(testPureState);
+  CPPUNIT_TEST(testApply);
+  CPPUNIT_TEST(testChannels);
+  CPPUNIT_TEST(testPartialTrace);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testPureState()
+    {
+      DensityMatrix d(2);
+      CPPUNIT_ASSERT( d.qubits() == 2 && d.dim() == 4 );
+      CPPUNIT_ASSERT( d(0,0) == field(1) && d(1,0) == field(0) );
+
+      Qubit q(8);
+      q.randomize();
+      q.normalize();
+      DensityMatrix e(q);
+      CPPUNIT_ASSERT( e.qubits() == 3 );
+      CPPUNIT_ASSERT( e.toMatrix().isApprox(q*q.adjoint()) );
+      CPPUNIT_ASSERT( std::abs(e.trace() - 1) < 1e-4 );
+      CPPUNIT_ASSERT( std::abs(e.purity() - 1) < 1e-4 );
+
+      const std::vector<fptype> p = e.probabilities(), r = q.probabilities();
+      for (int i = 0; i < 8; ++i) {
+        CPPUNIT_ASSERT( std::abs(p[i] - r[i]) < 1e-6 );
+      }
+      std::vector<int> t(2);
+      t[0] = 2;
+      t[1] = 0;
+      const std::vector<fptype> m = e.marginalProbabilities(t),
+                                mq = q.marginalProbabilities(t);
+      for (int i = 0; i < 4; ++i) {
+        CPPUNIT_ASSERT( std::abs(m[i] - mq[i]) < 1e-6 );
+      }
+    }
+
+    // Applying gates to |q><q| is the same as applying them to q.
+    void testApply()
+    {
+      Gate g[6];
+      Qubit q(16);
+      q.randomize();
+      q.normalize();
+      DensityMatrix d(q);
+      std::vector<int> t(2), c(1, 3);
+      t[0] = 2;
+      t[1] = 0;
+
+      d.apply(g[0].H(), 1).apply(g[1].Ry(0.4), 3).apply(g[2].CNOT(), 1);
+      d.apply(g[3].SWAP(), t).applyControlled(g[4].T(), 0, 2);
+      d.applyControlled(g[5].CNOT(), t, c, std::vector<int>(1, 0));
+      q.apply(g[0], 1).apply(g[1], 3).apply(g[2], 1);
+      q.apply(g[3], t).applyControlled(g[4], 0, 2);
+      q.applyControlled(g[5], t, c, std::vector<int>(1, 0));
+
+      CPPUNIT_ASSERT( d.toMatrix().isApprox(q*q.adjoint()) );
+    }
+
+    // The channels agree with the sums over their Kraus operators.
+    void testChannels()
+    {
+      Gate h, x, y, z, i;
+      Qubit q(8);
+      q.randomize();
+      q.normalize();
+      DensityMatrix d(q);
+      d.apply(h.H(), 0);
+      const MatrixXc rho = d.toMatrix();
+      const fptype p = 0.3;
+
+      DensityMatrix e = d;
+      e.depolarize(1, p);
+      const Gate x1 = x.X().applyTo(1,3), y1 = y.Y().applyTo(1,3),
+                 z1 = z.Z().applyTo(1,3);
+      MatrixXc r = (1-p)*rho + p/3*(x1*rho*x1.adjoint() +
+                   y1*rho*y1.adjoint() + z1*rho*z1.adjoint());
+      CPPUNIT_ASSERT( e.toMatrix().isApprox(r) );
+      CPPUNIT_ASSERT( std::abs(e.trace() - 1) < 1e-4 );
+      CPPUNIT_ASSERT( e.purity() < d.purity() );
+
+      e = d;
+      e.dephase(2, p);
+      const Gate z2 = z.Z().applyTo(2,3);
+      r = (1-p)*rho + p*z2*rho*z2.adjoint();
+      CPPUNIT_ASSERT( e.toMatrix().isApprox(r) );
+
+      e = d;
+      e.dampAmplitude(0, p);
+      Gate k0, k1;
+      k0.setZero();
+      k0(0,0) = 1;
+      k0(1,1) = std::sqrt(1-p);
+      k1.setZero();
+      k1(0,1) = std::sqrt(p);
+      const Gate k0a = k0.applyTo(0,3), k1a = k1.applyTo(0,3);
+      r = k0a*rho*k0a.adjoint() + k1a*rho*k1a.adjoint();
+      CPPUNIT_ASSERT( e.toMatrix().isApprox(r) );
+      CPPUNIT_ASSERT( std::abs(e.trace() - 1) < 1e-4 );
+
+      // Full amplitude damping resets the qubit to |0>.
+      e = d;
+      e.dampAmplitude(0, 1.);
+      std::vector<int> t(1, 0);
+      CPPUNIT_ASSERT( std::abs(e.marginalProbabilities(t)[0] - 1) < 1e-4 );
+
+      // Full depolarization leaves the maximally mixed state.
+      DensityMatrix f(1);
+      f.depolarize(0, 0.75);
+      CPPUNIT_ASSERT( f.toMatrix().isApprox(0.5*i.I()) );
+    }
+
+    void testPartialTrace()
+    {
+      // Bell state
+      Qubit b(4);
+      b(0) = b(3) = std::sqrt(0.5);
+      DensityMatrix d(b);
+      std::vector<int> t(1, 1);
+      Gate i;
+      CPPUNIT_ASSERT( d.partialTrace(t).toMatrix().isApprox(0.5*i.I()) );
+
+      // Product state: tracing out a factor leaves the other one.
+      Qubit x(4), y(2), z(2), w;
+      x.randomize();
+      x.normalize();
+      y.randomize();
+      y.normalize();
+      z.randomize();
+      z.normalize();
+      w = y.tensorDot(x).tensorDot(z);
+      DensityMatrix e(w);
+      t.resize(2);
+      t[0] = 3;
+      t[1] = 0;
+      const DensityMatrix r = e.partialTrace(t);
+      CPPUNIT_ASSERT( r.qubits() == 2 );
+      CPPUNIT_ASSERT( r.toMatrix().isApprox(x*x.adjoint()) );
+      CPPUNIT_ASSERT( e.partialTrace(std::vector<int>()).toMatrix().isApprox(
+                        e.toMatrix()) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_DENSITYMATRIXTEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -0,0 +1,138 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_DIAGONALGATETEST_H
+#define QUCOSI_DIAGONALGATETEST_H
+
+#include <cstdlib>
+#include <ctime>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Circuit>
+#include <QuCoSi/DiagonalGate>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class DiagonalGateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DiagonalGateTest);
+  CPPUNIT_TEST(testToGate);
+  CPPUNIT_TEST(testProduct);
+  CPPUNIT_TEST(testQubit);
+  CPPUNIT_TEST(testCircuit);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testToGate()
+    {
+      DiagonalGate d;
+      Gate g, u;
+
+      CPPUNIT_ASSERT( d.toGate(2).isApprox(g.I().tensorPow(2)) );
+      CPPUNIT_ASSERT( d.Z(1).toGate(3).isApprox(g.Z().applyTo(1,3)) );
+      CPPUNIT_ASSERT( d.P(0).toGate(2).isApprox(g.P().applyTo(0,2)) );
+      CPPUNIT_ASSERT( d.T(2).toGate(3).isApprox(g.T().applyTo(2,3)) );
+      CPPUNIT_ASSERT( d.R(8,0).toGate(1).isApprox(g.T()) );
+      CPPUNIT_ASSERT( d.R(5,1).toGate(2).isApprox(g.R(5).applyTo(1,2)) );
+      CPPUNIT_ASSERT( d.Rz(0.3,0).toGate(2).isApprox(
+                        g.Rz(0.3).applyTo(0,2)) );
+      CPPUNIT_ASSERT( d.CZ(0,1).toGate(2).isApprox(g.C(1,0,2,u.Z())) );
+      CPPUNIT_ASSERT( d.CR(4,2,0).toGate(3).isApprox(g.C(0,2,3,u.R(4))) );
+    }
+
+    void testProduct()
+    {
+      DiagonalGate a, b, c;
+      Gate g, h;
+
+      a.T(0);
+      b.CR(8,2,1);
+      c = a*b;
+      CPPUNIT_ASSERT( c.qubits().size() == 3 );
+      CPPUNIT_ASSERT( c.toGate(4).isApprox(a.toGate(4)*b.toGate(4)) );
+
+      // Gates on the same qubit stay on that qubit.
+      b.Rz(0.7,0);
+      c = a*b;
+      CPPUNIT_ASSERT( c.qubits().size() == 1 );
+      CPPUNIT_ASSERT( c.toGate(1).isApprox(g.T()*h.Rz(0.7)) );
+
+      c = DiagonalGate();
+      g = h.I().tensorPow(4);
+      for (int j = 0; j < 4; ++j) {
+        a.R(j+2,j);
+        b.CZ(j,(j+1)%4);
+        c = c*a*b;
+        g = g*a.toGate(4)*b.toGate(4);
+      }
+      CPPUNIT_ASSERT( c.qubits().size() == 4 );
+      CPPUNIT_ASSERT( c.toGate(4).isApprox(g) );
+    }
+
+    void testQubit()
+    {
+      DiagonalGate d, e, f;
+      Gate c, u;
+      Qubit q(32), x, y;
+      q.randomize();
+
+      d.CR(16,4,1);
+      x = d*q;
+      y = c.C(1,4,5,u.R(16))*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      e = d*e.Z(3)*f.T(1);
+      x = q;
+      e.transform(x);
+      y = c.T().applyTo(1,5)*y;
+      y = c.Z().applyTo(3,5)*y;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+
+    void testCircuit()
+    {
+      // Consecutive diagonal operations are merged in Circuit::run().
+      Gate g[9];
+      Qubit q(16), x, y;
+      q.randomize();
+
+      Circuit c(4);
+      c.H(0).T(0).C(2,1,g[0].R(8)).Z(3).CNOT(0,3).Rz(0.5,2).P(1);
+      x = c*q;
+      y = g[1].P().applyTo(1,4) * g[2].Rz(0.5).applyTo(2,4) *
+          g[3].C(3,0,4,g[6].X()) * g[4].Z().applyTo(3,4) *
+          g[5].C(2,1,4,g[0]) * g[7].T().applyTo(0,4) *
+          g[8].H().applyTo(0,4) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_DIAGONALGATETEST_H
+
+// vim: shiftwidth=2 textwidth=78
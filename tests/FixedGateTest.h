@@ -0,0 +1,125 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_FIXEDGATETEST_H
+#define QUCOSI_FIXEDGATETEST_H
+
+#include <cstdlib>
+#include <ctime>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/FixedGate>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class FixedGateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(FixedGateTest);
+  CPPUNIT_TEST(testConstants);
+  CPPUNIT_TEST(testRotations);
+  CPPUNIT_TEST(testShared);
+  CPPUNIT_TEST(testQubit);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testConstants()
+    {
+      Gate g, x;
+
+      CPPUNIT_ASSERT( g.I() == FixedGate::I() );
+      CPPUNIT_ASSERT( (FixedGate::X()*FixedGate::X()).isIdentity() );
+      CPPUNIT_ASSERT( (FixedGate::Y()*FixedGate::Y()).isIdentity() );
+      CPPUNIT_ASSERT( (FixedGate::Z()*FixedGate::Z()).isIdentity() );
+      CPPUNIT_ASSERT( (FixedGate::H()*FixedGate::H()).isIdentity() );
+      CPPUNIT_ASSERT( FixedGate::P().isApprox(
+                        FixedGate::T()*FixedGate::T()) );
+      CPPUNIT_ASSERT( FixedGate::Z().isApprox(
+                        FixedGate::P()*FixedGate::P()) );
+      CPPUNIT_ASSERT( FixedGate::Y().isApprox(
+                        field(0,1)*FixedGate::X()*FixedGate::Z()) );
+
+      CPPUNIT_ASSERT( FixedGate::CNOT() == g.C(1,0,2,x.X()) );
+      CPPUNIT_ASSERT( (FixedGate::CCNOT()*FixedGate::CCNOT()).isIdentity() );
+      CPPUNIT_ASSERT( FixedGate::CCNOT().block(0,0,6,6).isIdentity() );
+      CPPUNIT_ASSERT( FixedGate::CCNOT().block(6,6,2,2) == FixedGate::X() );
+      CPPUNIT_ASSERT( FixedGate::CSWAP() == g.C(1,0,3,x.SWAP()) );
+      CPPUNIT_ASSERT( (FixedGate::SWAP()*FixedGate::SWAP()).isIdentity() );
+      CPPUNIT_ASSERT( FixedGate::SWAP() == g.S(0,1,2) );
+    }
+
+    void testRotations()
+    {
+      const fptype theta = std::rand()/fptype(RAND_MAX);
+      Matrix2c m;
+
+      CPPUNIT_ASSERT( FixedGate::R(8).isApprox(FixedGate::T()) );
+      CPPUNIT_ASSERT( FixedGate::R(4).isApprox(FixedGate::P()) );
+      m = FixedGate::Rx(theta)*FixedGate::Rx(-theta);
+      CPPUNIT_ASSERT( m.isApprox(FixedGate::I()) );
+      m = FixedGate::Ry(c_pi);
+      CPPUNIT_ASSERT( m.isApprox(field(0,-1)*FixedGate::Y()) );
+      m = FixedGate::Rz(c_pi);
+      CPPUNIT_ASSERT( m.isApprox(field(0,-1)*FixedGate::Z()) );
+    }
+
+    void testShared()
+    {
+      // The constant gates are constructed once and shared afterwards.
+      CPPUNIT_ASSERT( &FixedGate::H() == &FixedGate::H() );
+      CPPUNIT_ASSERT( &FixedGate::CNOT() == &FixedGate::CNOT() );
+      CPPUNIT_ASSERT( &FixedGate::CSWAP() == &FixedGate::CSWAP() );
+    }
+
+    void testQubit()
+    {
+      const int n = 4;
+      Qubit q(1 << n), a, b;
+      q.randomize();
+      Gate g, u;
+
+      for (int j = 0; j < n; ++j) {
+        a = q;
+        b = q;
+        a.apply(FixedGate::T(), j);
+        b.apply(g.T(), j);
+        CPPUNIT_ASSERT( a.isApprox(b) );
+      }
+
+      a = q;
+      a.apply(FixedGate::CNOT(), 3, 1);
+      CPPUNIT_ASSERT( a.isApprox(g.C(1,3,n,u.X())*q) );
+      a = q;
+      a.apply(FixedGate::SWAP(), 0, 1);
+      CPPUNIT_ASSERT( a.isApprox(g.SWAP().applyTo(0,n)*q) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_FIXEDGATETEST_H
+
+// vim: shiftwidth=2 textwidth=78
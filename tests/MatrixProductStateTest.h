@@ -0,0 +1,253 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_MATRIXPRODUCTSTATETEST_H
+#define QUCOSI_MATRIXPRODUCTSTATETEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Circuit>
+#include <QuCoSi/Gate>
+#include <QuCoSi/MatrixProductState>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/RandomGenerator>
+
+namespace QuCoSi {
+
+class MatrixProductStateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MatrixProductStateTest);
+  CPPUNIT_TEST(testJacobiSvd);
+  CPPUNIT_TEST(testApply);
+  CPPUNIT_TEST(testTruncation);
+  CPPUNIT_TEST(testGhz);
+  CPPUNIT_TEST(testSample);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testJacobiSvd()
+    {
+      const int rows[3] = { 6, 3, 5 }, cols[3] = { 4, 7, 5 };
+      for (int k = 0; k < 3; ++k) {
+        MatrixXc a(rows[k], cols[k]);
+        for (int r = 0; r < a.rows(); ++r) {
+          for (int c = 0; c < a.cols(); ++c) {
+            a(r,c) = field(std::rand(), std::rand()) / fptype(RAND_MAX);
+          }
+        }
+        if (k == 2) {
+          // rank 4
+          a.col(4) = a.col(0) + field(0,2)*a.col(3);
+        }
+        MatrixXc u, v;
+        VectorXr s;
+        jacobi_svd(a, u, s, v);
+        const int m = std::min(rows[k], cols[k]);
+        CPPUNIT_ASSERT( u.rows() == rows[k] && u.cols() == m );
+        CPPUNIT_ASSERT( v.rows() == cols[k] && v.cols() == m );
+        for (int i = 1; i < m; ++i) {
+          CPPUNIT_ASSERT( s(i-1) >= s(i) );
+        }
+        MatrixXc us = u;
+        for (int i = 0; i < m; ++i) {
+          us.col(i) *= s(i);
+        }
+        CPPUNIT_ASSERT( (us*v.adjoint() - a).norm() < 1e-4*a.norm() );
+        CPPUNIT_ASSERT( (v.adjoint()*v - MatrixXc::Identity(m, m)).norm()
+                        < 1e-4 );
+        if (k == 2) {
+          CPPUNIT_ASSERT( s(4) < 1e-4*s(0) );
+        }
+        else {
+          CPPUNIT_ASSERT( (u.adjoint()*u - MatrixXc::Identity(m, m)).norm()
+                          < 1e-4 );
+        }
+      }
+    }
+
+    // Without truncation the state agrees with a Qubit, also for gates on
+    // qubits that are not adjacent.
+    void testApply()
+    {
+      const int n = 6;
+      Circuit c(n);
+      for (int k = 0; k < 30; ++k) {
+        const int a = std::rand() % n;
+        const int b = (a + 1 + std::rand() % (n-1)) % n;
+        int d = a;
+        while (d == a || d == b) {
+          d = std::rand() % n;
+        }
+        switch (std::rand() % 8) {
+          case 0: c.H(a); break;
+          case 1: c.Ry(0.3*k, a); break;
+          case 2: c.T(a); break;
+          case 3: c.CNOT(a, b); break;
+          case 4: c.SWAP(a, b); break;
+          case 5: c.Rx(0.7, b).CNOT(b, a); break;
+          default: c.CCNOT(a, d, b);
+        }
+      }
+      Gate g;
+      std::vector<int> t(1, 2), ctl(2, 0);
+      ctl[1] = 5;
+      c.C(g.H(), t, ctl, std::vector<int>(2, 0));
+
+      MatrixProductState m(n);
+      m.run(c);
+      Qubit q(0, n), x;
+      x = c*q;
+      CPPUNIT_ASSERT( m.toQubit().isApprox(x, 1e-4) );
+      CPPUNIT_ASSERT( m.discardedWeight() < 1e-6 );
+      for (int j = 0; j < n-1; ++j) {
+        CPPUNIT_ASSERT( m.bondDimension(j) <= 1 << std::min(j+1, n-1-j) );
+      }
+
+      std::vector<int> b(n);
+      for (int j = 0; j < n; ++j) {
+        b[j] = (37 >> (n-1-j)) & 1;
+      }
+      CPPUNIT_ASSERT( std::abs(m.amplitude(b) - x(37)) < 1e-4 );
+    }
+
+    void testTruncation()
+    {
+      const int n = 8;
+      Circuit c(n);
+      for (int layer = 0; layer < 6; ++layer) {
+        for (int j = 0; j < n; ++j) {
+          c.Ry(0.1 + 0.5*(std::rand() % 5), j);
+        }
+        for (int j = layer % 2; j < n-1; j += 2) {
+          c.CNOT(j, j+1);
+        }
+      }
+      Qubit q(0, n), x;
+      x = c*q;
+
+      MatrixProductState m(n);
+      m.setMaxBondDimension(2);
+      CPPUNIT_ASSERT( m.maxBondDimension() == 2 );
+      m.run(c);
+      for (int j = 0; j < n-1; ++j) {
+        CPPUNIT_ASSERT( m.bondDimension(j) <= 2 );
+      }
+      const Qubit y = m.toQubit();
+      CPPUNIT_ASSERT( std::abs(y.norm() - 1) < 1e-4 );
+      const fptype f = std::norm(braket(x, y));
+      CPPUNIT_ASSERT( f > 1 - 2*m.discardedWeight() - 1e-3 );
+
+      MatrixProductState e(n);
+      e.setTruncationError(1e-2);
+      CPPUNIT_ASSERT( e.truncationError() == fptype(1e-2) );
+      e.run(c);
+      const fptype g = std::norm(braket(x, e.toQubit()));
+      CPPUNIT_ASSERT( e.discardedWeight() <= 1e-2*c.size() );
+      CPPUNIT_ASSERT( g > 1 - 2*e.discardedWeight() - 1e-3 );
+    }
+
+    void testGhz()
+    {
+      const int n = 100;
+      MatrixProductState m(n);
+      Gate h, x;
+      m.apply(h.H(), 0);
+      for (int j = 1; j < n; ++j) {
+        m.applyControlled(x.X(), j, j-1);
+      }
+      for (int j = 0; j < n-1; ++j) {
+        CPPUNIT_ASSERT( m.bondDimension(j) == 2 );
+      }
+      // A CNOT between the ends moves the qubits across the chain.
+      m.applyControlled(x, n-1, 0);
+      CPPUNIT_ASSERT( m.discardedWeight() < 1e-6 );
+
+      RandomGenerator rng(std::rand());
+      const std::vector< std::vector<int> > r = m.sample(20, rng);
+      int ones = 0;
+      for (int k = 0; k < int(r.size()); ++k) {
+        for (int j = 1; j < n-1; ++j) {
+          CPPUNIT_ASSERT( r[k][j] == r[k][0] );
+        }
+        CPPUNIT_ASSERT( r[k][n-1] == 0 );
+        ones += r[k][0];
+      }
+      CPPUNIT_ASSERT( ones > 0 && ones < 20 );
+    }
+
+    // The samples follow the probabilities of the state.
+    void testSample()
+    {
+      const int n = 4;
+      Circuit c(n);
+      c.H(0).Ry(1.1,1).CNOT(0,2).Ry(0.4,3).CNOT(1,3).T(2).H(2);
+      MatrixProductState m(n);
+      m.run(c);
+      Qubit q(0, n), x;
+      x = c*q;
+
+      RandomGenerator rng(std::rand());
+      const int shots = 4000;
+      const std::vector< std::vector<int> > r = m.sample(shots, rng);
+      CPPUNIT_ASSERT( rng.counter() == uint64_t(shots)*n );
+      std::map<int,int> counts;
+      for (int k = 0; k < shots; ++k) {
+        int i = 0;
+        for (int j = 0; j < n; ++j) {
+          i = 2*i + r[k][j];
+        }
+        ++counts[i];
+      }
+      const std::vector<fptype> p = x.probabilities();
+      for (int i = 0; i < (1 << n); ++i) {
+        CPPUNIT_ASSERT( std::abs(fptype(counts[i])/shots - p[i]) < 0.04 );
+      }
+
+      RandomGenerator r1(7), r2(7);
+      CPPUNIT_ASSERT( m.sample(10, r1) == m.sample(10, r2) );
+    }
+
+  private:
+    static field braket(const Qubit& a, const Qubit& b)
+    {
+      field s = 0;
+      for (int i = 0; i < a.size(); ++i) {
+        s += std::conj(a(i))*b(i);
+      }
+      return s;
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_MATRIXPRODUCTSTATETEST_H
+
+// vim: shiftwidth=2 textwidth=78
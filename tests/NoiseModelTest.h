@@ -0,0 +1,163 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_NOISEMODELTEST_H
+#define QUCOSI_NOISEMODELTEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Circuit>
+#include <QuCoSi/DensityMatrix>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Hamiltonian>
+#include <QuCoSi/NoiseModel>
+#include <QuCoSi/Parallel>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/RandomGenerator>
+
+namespace QuCoSi {
+
+class NoiseModelTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(NoiseModelTest);
+  CPPUNIT_TEST(testNoiseless);
+  CPPUNIT_TEST(testDensityMatrix);
+  CPPUNIT_TEST(testDamping);
+  CPPUNIT_TEST(testThreadCounts);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown()
+    {
+      set_num_threads(0);
+    }
+
+    void testNoiseless()
+    {
+      Circuit c(3);
+      c.H(0).CNOT(0,1).Ry(0.7,2).CNOT(2,0);
+      Qubit q(0,3), x;
+      x = c*q;
+      RandomGenerator rng(std::rand());
+
+      const std::vector<fptype> p = NoiseModel().probabilities(c, q, 3, rng);
+      const std::vector<fptype> r = x.probabilities();
+      for (int i = 0; i < 8; ++i) {
+        CPPUNIT_ASSERT( std::abs(p[i] - r[i]) < 1e-6 );
+      }
+    }
+
+    // The average over the trajectories converges to the density matrix
+    // with the same channels.
+    void testDensityMatrix()
+    {
+      const fptype pd = 0.1, pz = 0.05, gamma = 0.1;
+      Circuit c(3);
+      c.H(0).CNOT(0,1).Ry(0.7,2).CNOT(2,0);
+      NoiseModel m;
+      m.depolarize(pd).dephase(pz).dampAmplitude(gamma);
+
+      DensityMatrix d(3);
+      for (int i = 0; i < c.size(); ++i) {
+        const Circuit::Operation& op = c.operation(i);
+        d.applyControlled(op.gate, op.targets, op.controls, op.values);
+        std::vector<int> w = op.targets;
+        w.insert(w.end(), op.controls.begin(), op.controls.end());
+        for (int k = 0; k < int(w.size()); ++k) {
+          d.depolarize(w[k], pd).dephase(w[k], pz);
+          d.dampAmplitude(w[k], gamma);
+        }
+      }
+
+      RandomGenerator rng(std::rand());
+      const int trajectories = 4000;
+      const std::vector<fptype> p =
+        m.probabilities(c, Qubit(0,3), trajectories, rng);
+      const std::vector<fptype> r = d.probabilities();
+      for (int i = 0; i < 8; ++i) {
+        // The standard deviation is at most 0.008.
+        CPPUNIT_ASSERT( std::abs(p[i] - r[i]) < 0.04 );
+      }
+
+      Hamiltonian h;
+      h.add("ZZI", 1.).add("XIX", 0.5);
+      const fptype e = m.expectation(c, Qubit(0,3), h, trajectories, rng);
+      fptype f = 0.;
+      for (int i = 0; i < 8; ++i) {
+        const int zz = ((i >> 2) ^ (i >> 1)) & 1;
+        f += (zz ? -1 : 1)*r[i];
+        f += 0.5*d(i ^ 5, i).real();
+      }
+      CPPUNIT_ASSERT( std::abs(e - f) < 0.08 );
+    }
+
+    void testDamping()
+    {
+      // |1> survives two operations with probability (1-gamma)^2.
+      const fptype gamma = 0.2;
+      Circuit c(1);
+      c.X(0).I(0);
+      NoiseModel m;
+      m.dampAmplitude(gamma);
+      RandomGenerator rng(std::rand());
+      const std::vector<fptype> p = m.probabilities(c, Qubit(0,1), 4000, rng);
+      CPPUNIT_ASSERT( std::abs(p[1] - (1-gamma)*(1-gamma)) < 0.04 );
+      CPPUNIT_ASSERT( std::abs(p[0] + p[1] - 1) < 1e-4 );
+    }
+
+    // The trajectories only depend on the generator, not on the number of
+    // threads.
+    void testThreadCounts()
+    {
+      Circuit c(4);
+      c.H(0).CNOT(0,1).CNOT(1,2).Rx(0.3,3).CNOT(3,0);
+      NoiseModel m;
+      m.depolarize(0.2).dephase(0.1);
+      const unsigned seed = std::rand();
+
+      set_num_threads(1);
+      RandomGenerator r1(seed);
+      const std::vector<fptype> p = m.probabilities(c, Qubit(0,4), 50, r1);
+      CPPUNIT_ASSERT( r1.counter() == 1 );
+
+      for (int t = 2; t <= 4; ++t) {
+        set_num_threads(t);
+        RandomGenerator r(seed);
+        const std::vector<fptype> s = m.probabilities(c, Qubit(0,4), 50, r);
+        for (int i = 0; i < 16; ++i) {
+          CPPUNIT_ASSERT( std::abs(s[i] - p[i]) < 1e-6 );
+        }
+      }
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_NOISEMODELTEST_H
+
+// vim: shiftwidth=2 textwidth=78
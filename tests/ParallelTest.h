@@ -0,0 +1,171 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_PARALLELTEST_H
+#define QUCOSI_PARALLELTEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/DiagonalGate>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Parallel>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class ParallelTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ParallelTest);
+  CPPUNIT_TEST(testNumThreads);
+  CPPUNIT_TEST(testParallelSum);
+  CPPUNIT_TEST(testReproducible);
+  CPPUNIT_TEST(testThreadCounts);
+  CPPUNIT_TEST(testMarginalProbabilities);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown()
+    {
+      set_num_threads(0);
+    }
+
+    void testNumThreads()
+    {
+      set_num_threads(3);
+      CPPUNIT_ASSERT( num_threads() == 3 );
+      CPPUNIT_ASSERT( parallel_threads(c_parallel_threshold) == 3 );
+      CPPUNIT_ASSERT( parallel_threads(c_parallel_threshold-1) == 1 );
+
+      set_num_threads(0);
+      CPPUNIT_ASSERT( num_threads() >= 1 );
+
+      CPPUNIT_ASSERT( chunk_begin(10, 0, 3) == 0 );
+      CPPUNIT_ASSERT( chunk_begin(10, 1, 3) == 3 );
+      CPPUNIT_ASSERT( chunk_begin(10, 3, 3) == 10 );
+    }
+
+    void testParallelSum()
+    {
+      Qubit q(1 << 15);
+      q.randomize();
+
+      for (int t = 1; t <= 4; ++t) {
+        set_num_threads(t);
+        fptype s = 0.;
+        for (int i = 0; i < q.size(); ++i) {
+          s += std::norm(q(i));
+        }
+        const fptype p = parallel_sum(q.size(), AbsSquared(q));
+        CPPUNIT_ASSERT( std::abs(p-s) <= q.size()*c_tolerance );
+      }
+    }
+
+    void testReproducible()
+    {
+      const int n = 16;
+      Qubit q(1 << n);
+      q.randomize();
+
+      for (int t = 1; t <= 4; ++t) {
+        set_num_threads(t);
+        Qubit a = q, b = q;
+        CPPUNIT_ASSERT( run(a, n) == run(b, n) );
+        CPPUNIT_ASSERT( a.squaredNorm() == b.squaredNorm() );
+      }
+    }
+
+    void testThreadCounts()
+    {
+      const int n = 15;
+      Qubit q(1 << n);
+      q.randomize();
+
+      set_num_threads(1);
+      Qubit a = q;
+      run(a, n);
+
+      for (int t = 2; t <= 4; ++t) {
+        set_num_threads(t);
+        Qubit b = q;
+        CPPUNIT_ASSERT( run(b, n).isApprox(a) );
+        CPPUNIT_ASSERT( std::abs(b.norm()-a.norm()) <=
+                        q.size()*c_tolerance );
+      }
+    }
+
+    // The reduction over the threads is deterministic and agrees with
+    // the sequential one up to rounding.
+    void testMarginalProbabilities()
+    {
+      Qubit q(1 << 15);
+      q.randomize();
+      std::vector<int> t(2);
+      t[0] = 14;
+      t[1] = 3;
+
+      set_num_threads(1);
+      const std::vector<fptype> p = q.marginalProbabilities(t);
+
+      for (int n = 2; n <= 4; ++n) {
+        set_num_threads(n);
+        const std::vector<fptype> a = q.marginalProbabilities(t);
+        CPPUNIT_ASSERT( q.marginalProbabilities(t) == a );
+        for (int x = 0; x < 4; ++x) {
+          CPPUNIT_ASSERT( std::abs(a[x]-p[x]) <= q.size()*c_tolerance*p[x] );
+        }
+      }
+    }
+
+  private:
+    // Runs every parallel kernel of Qubit and DiagonalGate once on q.
+    Qubit& run(Qubit& q, const int n)
+    {
+      Gate h, u, x;
+      std::vector<int> sigma(n), f(1 << (n-2));
+      for (int i = 0; i < n; ++i) {
+        sigma[i] = (i+3) % n;
+      }
+      for (int i = 0; i < int(f.size()); ++i) {
+        f[i] = (5*i) % 4;
+      }
+      DiagonalGate d;
+      d.CR(8, 2, n-1);
+
+      q.apply(h.H(), 0).apply(h, n-1).apply(u.CNOT(), 3);
+      q.applyControlled(x.X(), 1, 4).applyControlled(u, n-3, 0);
+      q.permuteQubits(sigma).swapQubits(2, 7).applyOracle(f, 2);
+      q.qft(0, n).inverseQft(1, n-2);
+      return d.transform(q);
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_PARALLELTEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -0,0 +1,176 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_PAULISTRINGTEST_H
+#define QUCOSI_PAULISTRINGTEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Hamiltonian>
+#include <QuCoSi/PauliString>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class PauliStringTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PauliStringTest);
+  CPPUNIT_TEST(testFactors);
+  CPPUNIT_TEST(testCommutes);
+  CPPUNIT_TEST(testTransform);
+  CPPUNIT_TEST(testExpectation);
+  CPPUNIT_TEST(testHamiltonian);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testFactors()
+    {
+      PauliString p(0.5);
+      p.X(0).Z(3).Y(5);
+      CPPUNIT_ASSERT( p.toString(6) == "XIIZIY" );
+      CPPUNIT_ASSERT( p.xMask() == 33 && p.zMask() == 40 );
+      CPPUNIT_ASSERT( p.weight() == 3 );
+      CPPUNIT_ASSERT( p.coefficient() == 0.5 );
+      CPPUNIT_ASSERT( p.flipMask(6) == 33 && p.phaseMask(6) == 5 );
+      CPPUNIT_ASSERT( p.phase() == field(0,1) );
+
+      PauliString s("XIIZIY", 0.5);
+      CPPUNIT_ASSERT( s.xMask() == p.xMask() && s.zMask() == p.zMask() );
+      p.I(5).Z(0);
+      CPPUNIT_ASSERT( p.toString(6) == "ZIIZII" );
+      CPPUNIT_ASSERT( p.phase() == field(1) );
+    }
+
+    void testCommutes()
+    {
+      CPPUNIT_ASSERT( PauliString("XX").commutesWith(PauliString("ZZ")) );
+      CPPUNIT_ASSERT( PauliString("XX").commutesWith(PauliString("YY")) );
+      CPPUNIT_ASSERT( !PauliString("XI").commutesWith(PauliString("ZI")) );
+      CPPUNIT_ASSERT( PauliString("XYZ").commutesWith(PauliString("YYY")) );
+      CPPUNIT_ASSERT( !PauliString("XYZ").commutesWith(PauliString("YYI")) );
+      CPPUNIT_ASSERT( PauliString("XIZ").commutesWith(PauliString("IYI")) );
+    }
+
+    void testTransform()
+    {
+      const char* s[] = { "ZIII", "XIYI", "IYZX", "YYYY", "IIII" };
+      Qubit q(16), x, y;
+      q.randomize();
+      for (int i = 0; i < 5; ++i) {
+        x = q;
+        PauliString(s[i]).transform(x);
+        y = toGate(s[i])*q;
+        CPPUNIT_ASSERT( x.isApprox(y) );
+      }
+    }
+
+    void testExpectation()
+    {
+      const char* s[] = { "ZIIII", "XIZIY", "IYYXI", "YYYYZ", "IIIII" };
+      Qubit q(32), y;
+      q.randomize();
+      q.normalize();
+      for (int i = 0; i < 5; ++i) {
+        y = toGate(s[i])*q;
+        const fptype e = 0.7*braket(q, y);
+        const fptype p = PauliString(s[i], 0.7).expectation(q);
+        CPPUNIT_ASSERT( std::abs(p - e) < 1e-4 );
+      }
+
+      // Bell state
+      Qubit b(4);
+      b(0) = b(3) = std::sqrt(0.5);
+      const fptype zz = PauliString("ZZ").expectation(b);
+      const fptype xx = PauliString("XX").expectation(b);
+      const fptype yy = PauliString("YY").expectation(b);
+      const fptype zi = PauliString("ZI").expectation(b);
+      CPPUNIT_ASSERT( std::abs(zz - 1) < 1e-6 && std::abs(xx - 1) < 1e-6 );
+      CPPUNIT_ASSERT( std::abs(yy + 1) < 1e-6 && std::abs(zi) < 1e-6 );
+    }
+
+    void testHamiltonian()
+    {
+      const char* s[] = { "ZZII", "IZZI", "IIZZ", "XIII", "IXII", "IIXI",
+                          "IIIX", "YYII", "XIXI", "IIII" };
+      Hamiltonian h;
+      Qubit q(16), y;
+      q.randomize();
+      q.normalize();
+
+      fptype e = 0., f = 0.;
+      for (int i = 0; i < 10; ++i) {
+        const fptype c = 0.1*(i+1)*(i % 2 ? -1 : 1);
+        h.add(s[i], c);
+        y = toGate(s[i])*q;
+        e += c*braket(q, y);
+        f += PauliString(s[i], c).expectation(q);
+      }
+      CPPUNIT_ASSERT( h.size() == 10 );
+      CPPUNIT_ASSERT( std::abs(h.expectation(q) - e) < 1e-4 );
+      CPPUNIT_ASSERT( std::abs(h.expectation(q) - f) < 1e-4 );
+
+      CPPUNIT_ASSERT( Hamiltonian().expectation(q) == 0 );
+    }
+
+  private:
+    static fptype braket(const Qubit& a, const Qubit& b)
+    {
+      field s = 0;
+      for (int i = 0; i < a.size(); ++i) {
+        s += std::conj(a(i))*b(i);
+      }
+      return s.real();
+    }
+
+    // Builds the dense matrix of the Pauli string s.
+    static Gate toGate(const std::string& s)
+    {
+      const int n = s.size();
+      Gate g, f;
+      g.I().tensorPowSet(n);
+      for (int j = 0; j < n; ++j) {
+        switch (s[j]) {
+          case 'X': f.X(); break;
+          case 'Y': f.Y(); break;
+          case 'Z': f.Z(); break;
+          default: f.I();
+        }
+        g = g*f.applyTo(j, n);
+      }
+      return g;
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_PAULISTRINGTEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -0,0 +1,160 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_PERMUTATIONGATETEST_H
+#define QUCOSI_PERMUTATIONGATETEST_H
+
+#include <cstdlib>
+#include <ctime>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Gate>
+#include <QuCoSi/PermutationGate>
+#include <QuCoSi/Qubit>
+
+namespace QuCoSi {
+
+class PermutationGateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PermutationGateTest);
+  CPPUNIT_TEST(testToGate);
+  CPPUNIT_TEST(testProduct);
+  CPPUNIT_TEST(testTensorDot);
+  CPPUNIT_TEST(testQubit);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testToGate()
+    {
+      PermutationGate p;
+      Gate g;
+
+      CPPUNIT_ASSERT( p.I().toGate() == g.I() );
+      CPPUNIT_ASSERT( p.X().toGate() == g.X() );
+      CPPUNIT_ASSERT( p.Y().toGate() == g.Y() );
+      CPPUNIT_ASSERT( p.CNOT().toGate() == g.CNOT() );
+      CPPUNIT_ASSERT( p.CCNOT().toGate() == g.CCNOT() );
+      CPPUNIT_ASSERT( p.CSWAP().toGate() == g.CSWAP() );
+      CPPUNIT_ASSERT( p.SWAP().toGate() == g.SWAP() );
+      CPPUNIT_ASSERT( p.S(0,3,4).toGate() == g.S(0,3,4) );
+
+      std::vector<int> sigma(4);
+      sigma[0] = 2;
+      sigma[1] = 0;
+      sigma[2] = 3;
+      sigma[3] = 1;
+      CPPUNIT_ASSERT( p.S(sigma).toGate() == g.S(sigma) );
+
+      std::vector<int> f(4);
+      f[0] = 1;
+      f[1] = 0;
+      f[2] = 0;
+      f[3] = 1;
+      CPPUNIT_ASSERT( p.U(f).toGate() == g.U(f) );
+
+      f[0] = 3;
+      f[1] = 0;
+      f[2] = 2;
+      f[3] = 1;
+      CPPUNIT_ASSERT( p.U(f,2).toGate() == g.U(f,2) );
+
+      CPPUNIT_ASSERT( !p.CNOT().hasPhases() );
+      CPPUNIT_ASSERT( p.Y().hasPhases() );
+    }
+
+    void testProduct()
+    {
+      PermutationGate p, q, r;
+      Gate g, h;
+
+      // Permutation times permutation stays a permutation.
+      p.CNOT();
+      q.SWAP();
+      r = q*p*q;
+      CPPUNIT_ASSERT( r.toGate() == g.SWAP()*h.CNOT()*g );
+      CPPUNIT_ASSERT( r.toGate() == h.C(0,1,2,g.X()) );
+      CPPUNIT_ASSERT( p*p == PermutationGate(4) );
+
+      p.Y();
+      q.X();
+      CPPUNIT_ASSERT( (p*q).toGate().isApprox(g.Y()*h.X()) );
+      CPPUNIT_ASSERT( (q*p).toGate().isApprox(h*g) );
+      CPPUNIT_ASSERT( (p*p).toGate().isApprox(g.I()) );
+
+      // Mixed products fall back to dense gates.
+      g.H();
+      CPPUNIT_ASSERT( (p*g).isApprox(p.toGate()*g) );
+      CPPUNIT_ASSERT( (g*p).isApprox(g*p.toGate()) );
+
+      p.CCNOT();
+      g.Ry(0.4).applyToSet(1,3);
+      CPPUNIT_ASSERT( (p*g).isApprox(p.toGate()*g) );
+      CPPUNIT_ASSERT( (g*p).isApprox(g*p.toGate()) );
+    }
+
+    void testTensorDot()
+    {
+      PermutationGate p, q;
+      Gate g, h;
+
+      p.Y();
+      q.CNOT();
+      CPPUNIT_ASSERT( p.tensorDot(q).toGate() == g.Y().tensorDot(h.CNOT()) );
+      CPPUNIT_ASSERT( q.tensorDot(p).toGate() == h.tensorDot(g) );
+
+      for (int j = 0; j < 3; ++j) {
+        CPPUNIT_ASSERT( q.applyTo(j,4).toGate() == h.applyTo(j,4) );
+      }
+    }
+
+    void testQubit()
+    {
+      PermutationGate p;
+      Gate g;
+      Qubit q(64), x, y;
+      q.randomize();
+
+      std::vector<int> f(32);
+      for (int i = 0; i < 32; ++i) {
+        f[i] = std::rand() % 2;
+      }
+      p.U(f);
+      x = p*q;
+      y = g.U(f)*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      p.Y().applyToSet(2,6);
+      x = q;
+      p.transform(x);
+      y = g.Y().applyTo(2,6)*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_PERMUTATIONGATETEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -17,13 +17,19 @@
 #ifndef QUCOSI_QUBITTEST_H
 #define QUCOSI_QUBITTEST_H
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstdlib>
 #include <ctime>
+#include <map>
+#include <vector>
 
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <QuCoSi/Gate>
+#include <QuCoSi/Parallel>
 #include <QuCoSi/Qubit>
 
 namespace QuCoSi {
@@ -33,7 +39,18 @@ class QubitTest : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(QubitTest);
   CPPUNIT_TEST(testFirstLast);
   CPPUNIT_TEST(testMeasure);
+  CPPUNIT_TEST(testMeasureLargeFloat);
   CPPUNIT_TEST(testMeasurePartial);
+  CPPUNIT_TEST(testMeasureQubits);
+  CPPUNIT_TEST(testSample);
+  CPPUNIT_TEST(testMarginalProbabilities);
+  CPPUNIT_TEST(testApply);
+  CPPUNIT_TEST(testApplyControlled);
+  CPPUNIT_TEST(testPermuteQubits);
+  CPPUNIT_TEST(testApplyOracle);
+  CPPUNIT_TEST(testQft);
+  CPPUNIT_TEST(testQftParallel);
+  CPPUNIT_TEST(testPrecision);
   CPPUNIT_TEST_SUITE_END();
 
   public:
@@ -42,7 +59,10 @@ class QubitTest : public CppUnit::TestFixture
       std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
     }
 
-    void tearDown() {}
+    void tearDown()
+    {
+      set_num_threads(0);
+    }
 
     void testFirstLast()
     {
@@ -111,6 +131,31 @@ class QubitTest : public CppUnit::TestFixture
       CPPUNIT_ASSERT( r2 > 200 && r2 < 300);
     }
 
+    // A float sum of 2^25 equal probabilities stops growing at 0.5, which
+    // left the qubit uncollapsed for random numbers above that.
+    void testMeasureLargeFloat()
+    {
+      const int n = 25, dim = 1 << n;
+      BasicQubit<float> q(0, n);
+      q.setConstant(std::complex<float>(float(std::sqrt(1./dim)), 0.f));
+
+      RandomGenerator rng(std::rand());
+      while (rng.uniformAt(rng.counter()) < 0.75) {
+        rng.skip(1);
+      }
+      q.measure(rng);
+
+      int x = -1, nonzero = 0;
+      for (int i = 0; i < dim; ++i) {
+        if (q(i) != std::complex<float>(0.f, 0.f)) {
+          x = i;
+          ++nonzero;
+        }
+      }
+      CPPUNIT_ASSERT( nonzero == 1 && x >= dim/2 );
+      CPPUNIT_ASSERT( std::abs(std::abs(q(x)) - 1) < 1e-6 );
+    }
+
     void testMeasurePartial()
     {
       Qubit b, r1, r2, q0(0,2), q1(1,2), q2(2,2), q3(3,2);
@@ -127,6 +172,378 @@ class QubitTest : public CppUnit::TestFixture
       r2 = q3;
       CPPUNIT_ASSERT( b.isApprox(r1) || b.isApprox(r2) );
     }
+
+    void testMeasureQubits()
+    {
+      Qubit b, q0(0,2), q1(1,2), q2(2,2);
+      std::vector<int> t(1, 1);
+
+      // The second qubit is 1 with probability 0.25.
+      int n = 0, r1 = 0;
+      for (; n < 1000; ++n) {
+        b = std::sqrt(0.5)*q0 - 0.5*q1 + 0.5*q2;
+        const int x = b.measureQubits(t);
+        if (x == 1) {
+          ++r1;
+          CPPUNIT_ASSERT( b.isApprox(-1*q1) );
+        }
+        else {
+          CPPUNIT_ASSERT( x == 0 );
+          Qubit r;
+          r = std::sqrt(2./3.)*q0 + std::sqrt(1./3.)*q2;
+          CPPUNIT_ASSERT( b.isApprox(r) );
+        }
+      }
+      CPPUNIT_ASSERT( r1 > 200 && r1 < 300 );
+
+      // Measuring one qubit of a GHZ state determines the others.
+      b = std::sqrt(0.5)*(Qubit(0,3) + Qubit(7,3));
+      t[0] = 1;
+      const int x = b.measureQubits(t);
+      CPPUNIT_ASSERT( b.isApprox(Qubit(7*x,3)) );
+
+      // Unmeasured qubits keep their amplitudes up to normalization.
+      Qubit q(1 << 10), v;
+      q.randomize();
+      q.normalize();
+      v = q;
+      t.resize(2);
+      t[0] = 7;
+      t[1] = 2;
+      const int y = v.measureQubits(t);
+      CPPUNIT_ASSERT( std::abs(v.norm() - 1) < 1e-4 );
+      fptype scale = 0.;
+      for (int i = 0; i < q.size(); ++i) {
+        const int z = (((i >> 2) & 1) << 1) | ((i >> 7) & 1);
+        if (z != y) {
+          CPPUNIT_ASSERT( v(i) == field(0) );
+        }
+        else if (std::abs(q(i)) > 0) {
+          if (scale == 0) {
+            scale = std::abs(v(i))/std::abs(q(i));
+          }
+          CPPUNIT_ASSERT( std::abs(v(i) - scale*q(i)) < 1e-4*scale );
+        }
+      }
+    }
+
+    void testSample()
+    {
+      Qubit v, x, q0(0,2), q1(1,2), q2(2,2);
+      x = std::sqrt(0.5)*q0 - 0.5*q1 + 0.5*q2;
+      v = x;
+
+      const int n = 100000;
+      const std::vector<int> s = x.sample(n);
+      CPPUNIT_ASSERT( int(s.size()) == n );
+      CPPUNIT_ASSERT( std::count(s.begin(), s.end(), 3) == 0 );
+
+      std::map<int,int> c = x.sampleCounts(n);
+      CPPUNIT_ASSERT( c[0] + c[1] + c[2] == n );
+      CPPUNIT_ASSERT( c.count(3) == 0 );
+      CPPUNIT_ASSERT( c[0] > 48500 && c[0] < 51500 );
+      CPPUNIT_ASSERT( c[1] > 23500 && c[1] < 26500 );
+      CPPUNIT_ASSERT( c[2] > 23500 && c[2] < 26500 );
+
+      // Sampling does not collapse the state.
+      CPPUNIT_ASSERT( x == v );
+
+      c = q1.sampleCounts(10);
+      CPPUNIT_ASSERT( c.size() == 1 && c[1] == 10 );
+    }
+
+    void testMarginalProbabilities()
+    {
+      Qubit q(1 << 12), v;
+      q.randomize();
+      q.normalize();
+      v = q;
+      std::vector<int> t(3);
+      t[0] = 9;
+      t[1] = 0;
+      t[2] = 4;
+
+      const std::vector<fptype> p = q.marginalProbabilities(t);
+      const std::vector<fptype> all = q.probabilities();
+      std::vector<fptype> r(8, 0.);
+      for (int i = 0; i < q.size(); ++i) {
+        r[(((i >> 2) & 1) << 2) | (((i >> 11) & 1) << 1) | ((i >> 7) & 1)]
+          += all[i];
+      }
+      CPPUNIT_ASSERT( p.size() == 8 );
+      fptype sum = 0.;
+      for (int x = 0; x < 8; ++x) {
+        CPPUNIT_ASSERT( std::abs(p[x] - r[x]) < 1e-4 );
+        sum += p[x];
+      }
+      CPPUNIT_ASSERT( std::abs(sum - 1) < 1e-4 );
+      CPPUNIT_ASSERT( q == v );
+
+      // Without qubits the only outcome is certain.
+      const std::vector<fptype> p0 =
+        q.marginalProbabilities(std::vector<int>());
+      CPPUNIT_ASSERT( p0.size() == 1 && std::abs(p0[0] - 1) < 1e-4 );
+
+      Qubit b, q0(0,2), q1(1,2), q2(2,2);
+      b = std::sqrt(0.5)*q0 - 0.5*q1 + 0.5*q2;
+      t.assign(1, 0);
+      const std::vector<fptype> p1 = b.marginalProbabilities(t);
+      CPPUNIT_ASSERT( std::abs(p1[0] - 0.75) < 1e-6 );
+      CPPUNIT_ASSERT( std::abs(p1[1] - 0.25) < 1e-6 );
+    }
+
+    void testApply()
+    {
+      Qubit q(16), x, y;
+      Gate g[4];
+      g[0].H();
+      g[1].Ry(0.3);
+      g[2].T();
+      g[3].CNOT();
+      q.randomize();
+
+      // Single-qubit gates at every position.
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          x = q;
+          x.apply(g[i], j);
+          y = g[i].applyTo(j,4) * q;
+          CPPUNIT_ASSERT( x.isApprox(y) );
+        }
+      }
+
+      // Two-qubit gates at contiguous positions.
+      for (int j = 0; j < 3; ++j) {
+        x = q;
+        x.apply(g[3], j);
+        y = g[3].applyTo(j,4) * q;
+        CPPUNIT_ASSERT( x.isApprox(y) );
+      }
+
+      // A SWAP gate on two non-adjacent qubits.
+      std::vector<int> t(2);
+      t[0] = 3;
+      t[1] = 1;
+      x = q;
+      x.apply(g[0].SWAP(), t);
+      y = g[1].S(1,3,4) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // The order of the target qubits matters for non-symmetric gates.
+      x = q;
+      x.apply(g[3], t);
+      y = g[0].C(1,3,4,g[2].X()) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+
+    void testApplyControlled()
+    {
+      Qubit q(16), x, y;
+      Gate c, u, g;
+      q.randomize();
+
+      // Single controls for all pairs of target and control qubit.
+      for (int t = 0; t < 4; ++t) {
+        for (int k = 0; k < 4; ++k) {
+          if (t == k) continue;
+          x = q;
+          x.applyControlled(u.Ry(0.7), t, k);
+          y = c.C(t,k,4,u) * q;
+          CPPUNIT_ASSERT( x.isApprox(y) );
+        }
+      }
+
+      // Multi-qubit target gates.
+      x = q;
+      x.applyControlled(u.SWAP(), 1, 0);
+      y = c.CSWAP().applyTo(0,4) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // Multiple controls.
+      std::vector<int> cs(2), t(1), v(2);
+      cs[0] = 0;
+      cs[1] = 1;
+      x = q;
+      x.applyControlled(u.X(), 2, cs);
+      y = c.CCNOT().applyTo(0,4) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // Controls that trigger on |0>.
+      cs[0] = 3;
+      cs[1] = 0;
+      t[0] = 1;
+      v[0] = 0;
+      v[1] = 1;
+      x = q;
+      x.applyControlled(u.H(), t, cs, v);
+      y = q;
+      y.apply(g.X(), 3);
+      y.applyControlled(u, 1, cs);
+      y.apply(g, 3);
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // A gate without targets multiplies the state by its only entry.
+      Gate p(1, 1);
+      p(0,0) = field(0,1);
+      x = q;
+      x.apply(p, std::vector<int>());
+      y = field(0,1)*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+
+    void testPermuteQubits()
+    {
+      Qubit q(32), x, y;
+      Gate s;
+      q.randomize();
+
+      std::vector<int> sigma(5);
+      sigma[0] = 3;
+      sigma[1] = 0;
+      sigma[2] = 4;
+      sigma[3] = 1;
+      sigma[4] = 2;
+      x = q;
+      x.permuteQubits(sigma);
+      y = s.S(sigma) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // The identity permutation leaves the state unchanged.
+      for (int i = 0; i < 5; ++i) {
+        sigma[i] = i;
+      }
+      x = q;
+      CPPUNIT_ASSERT( x.permuteQubits(sigma) == q );
+
+      for (int p = 0; p < 5; ++p) {
+        for (int r = 0; r < 5; ++r) {
+          x = q;
+          x.swapQubits(p,r);
+          y = s.S(p,r,5) * q;
+          CPPUNIT_ASSERT( x.isApprox(y) );
+        }
+      }
+    }
+
+    void testApplyOracle()
+    {
+      Qubit q(32), x, y;
+      Gate u;
+      q.randomize();
+
+      // One output qubit.
+      std::vector<int> f(16);
+      for (int i = 0; i < 16; ++i) {
+        f[i] = std::rand() % 2;
+      }
+      x = q;
+      x.applyOracle(f);
+      y = u.U(f) * q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      // Multiple output qubits.
+      for (int m = 1; m <= 4; ++m) {
+        std::vector<int> g(32 >> m);
+        for (int i = 0; i < int(g.size()); ++i) {
+          g[i] = std::rand() % (1 << m);
+        }
+        x = q;
+        x.applyOracle(g, m);
+        y = u.U(g, m) * q;
+        CPPUNIT_ASSERT( x.isApprox(y) );
+      }
+    }
+
+    void testQft()
+    {
+      Qubit q(32), x, y;
+      Gate f;
+      q.randomize();
+
+      for (int first = 0; first < 5; ++first) {
+        for (int count = 1; first+count <= 5; ++count) {
+          x = q;
+          x.qft(first, count);
+          y = f.F(count).applyTo(first,5) * q;
+          CPPUNIT_ASSERT( x.isApprox(y) );
+
+          x.inverseQft(first, count);
+          CPPUNIT_ASSERT( x.isApprox(q) );
+        }
+      }
+    }
+
+    // qft(0, n) has a single column, whose butterflies are shared by the
+    // threads. F(n) is too large to build for enough amplitudes to run in
+    // parallel, so some of its rows are applied one by one.
+    void testQftParallel()
+    {
+      const int n = 15, dim = 1 << n;
+      Qubit q(dim), x;
+      q.randomize();
+
+      for (int first = 0; first < 2; ++first) {
+        set_num_threads(4);
+        x = q;
+        x.qft(first, n-first);
+
+        const int len = dim >> first;
+        for (int r = 0; r < 16; ++r) {
+          const int row = std::rand() % dim;
+          const int k = row % len, base = row - k;
+          std::complex<double> e = 0.;
+          for (int y = 0; y < len; ++y) {
+            const double phi =
+              2*Precision<double>::pi()*((long(k)*y) % len)/len;
+            e += std::polar(1., phi)*std::complex<double>(q(base + y));
+          }
+          e /= std::sqrt(double(len));
+          CPPUNIT_ASSERT( std::abs(std::complex<double>(x(row)) - e) < 1e-4 );
+        }
+
+        set_num_threads(1);
+        Qubit y = q;
+        y.qft(first, n-first);
+        CPPUNIT_ASSERT( x.isApprox(y) );
+
+        set_num_threads(4);
+        x.inverseQft(first, n-first);
+        CPPUNIT_ASSERT( x.isApprox(q) );
+      }
+    }
+
+    // Single- and double-precision qubits can be used side by side.
+    void testPrecision()
+    {
+      CPPUNIT_ASSERT( sizeof(BasicQubit<float>::field) == 8 );
+      CPPUNIT_ASSERT( sizeof(BasicQubit<double>::field) == 16 );
+
+      BasicQubit<float> s(0, 6);
+      BasicQubit<double> d(0, 6);
+      BasicGate<float> gs;
+      BasicGate<double> gd;
+      for (int j = 0; j < 6; ++j) {
+        s.apply(gs.H(), j);
+        d.apply(gd.H(), j);
+      }
+      s.apply(BasicFixedGate<float>::T(), 2);
+      d.apply(BasicFixedGate<double>::T(), 2);
+      s.applyControlled(gs.Ry(0.3), 4, 1);
+      d.applyControlled(gd.Ry(0.3), 4, 1);
+      s.qft(1, 4);
+      d.qft(1, 4);
+      for (int i = 0; i < 64; ++i) {
+        CPPUNIT_ASSERT( std::abs(std::complex<double>(s(i)) - d(i)) < 1e-5 );
+      }
+      CPPUNIT_ASSERT( std::abs(s.norm() - 1) < 1e-5 && d.isNormalized() );
+
+      const std::vector<float> p = s.probabilities();
+      const std::map<int,int> counts = s.sampleCounts(100);
+      CPPUNIT_ASSERT( int(p.size()) == 64 && !counts.empty() );
+      const int x = s.measureQubits(std::vector<int>(1, 5));
+      CPPUNIT_ASSERT( x == 0 || x == 1 );
+      CPPUNIT_ASSERT( std::abs(s.norm() - 1) < 1e-5 );
+    }
 };
 
 } // namespace QuCoSi
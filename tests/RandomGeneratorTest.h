@@ -0,0 +1,258 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_RANDOMGENERATORTEST_H
+#define QUCOSI_RANDOMGENERATORTEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/FixedGate>
+#include <QuCoSi/Parallel>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/RandomGenerator>
+
+namespace QuCoSi {
+
+class RandomGeneratorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(RandomGeneratorTest);
+  CPPUNIT_TEST(testReproducible);
+  CPPUNIT_TEST(testCounter);
+  CPPUNIT_TEST(testStreams);
+  CPPUNIT_TEST(testUniform);
+  CPPUNIT_TEST(testResolution);
+  CPPUNIT_TEST(testChiSquare);
+  CPPUNIT_TEST(testBits);
+  CPPUNIT_TEST(testSerialCorrelation);
+  CPPUNIT_TEST(testSample);
+  CPPUNIT_TEST(testMeasure);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+      m_seed = uint64_t(std::rand()) << 32 | uint64_t(std::rand());
+    }
+
+    void tearDown()
+    {
+      set_num_threads(0);
+    }
+
+    void testReproducible()
+    {
+      RandomGenerator a(m_seed), b(m_seed);
+      for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT( a() == b() );
+      }
+      CPPUNIT_ASSERT( a.counter() == 100 );
+
+      a.reseed(m_seed);
+      RandomGenerator c(m_seed);
+      CPPUNIT_ASSERT( a.counter() == 0 );
+      CPPUNIT_ASSERT( a.seed() == m_seed );
+      for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT( a.uniform() == c.uniform() );
+      }
+    }
+
+    void testCounter()
+    {
+      RandomGenerator a(m_seed), b(m_seed);
+      std::vector<uint64_t> x(50);
+      for (int i = 0; i < 50; ++i) {
+        x[i] = a();
+      }
+      for (int i = 0; i < 50; ++i) {
+        CPPUNIT_ASSERT( b.at(i) == x[i] );
+      }
+      CPPUNIT_ASSERT( b.counter() == 0 );
+
+      b.skip(20);
+      CPPUNIT_ASSERT( b() == x[20] );
+      b.setCounter(7);
+      CPPUNIT_ASSERT( b() == x[7] );
+      CPPUNIT_ASSERT( b.counter() == 8 );
+    }
+
+    void testStreams()
+    {
+      RandomGenerator a(m_seed), b = a.stream(1), c(m_seed+1);
+      CPPUNIT_ASSERT( b.seed() == m_seed );
+      CPPUNIT_ASSERT( b.streamNumber() == 1 );
+
+      int equal_b = 0, equal_c = 0;
+      for (int i = 0; i < 100; ++i) {
+        const uint64_t x = a();
+        equal_b += x == b();
+        equal_c += x == c();
+      }
+      CPPUNIT_ASSERT( equal_b == 0 );
+      CPPUNIT_ASSERT( equal_c == 0 );
+    }
+
+    void testUniform()
+    {
+      RandomGenerator r(m_seed);
+      const int n = 100000;
+      fptype sum = 0., sum2 = 0.;
+      for (int i = 0; i < n; ++i) {
+        const fptype u = r.uniform();
+        CPPUNIT_ASSERT( u >= 0. && u < 1. );
+        sum += u;
+        sum2 += u*u;
+      }
+      const fptype mean = sum/n, var = sum2/n - mean*mean;
+      // The standard error of the mean is about 0.001.
+      CPPUNIT_ASSERT( std::abs(mean - 0.5) < 0.01 );
+      CPPUNIT_ASSERT( std::abs(var - 1./12) < 0.01 );
+    }
+
+    // uniform() has 53 random bits, also if fptype is float.
+    void testResolution()
+    {
+      RandomGenerator r(m_seed);
+      const double scale = double(uint64_t(1) << 53);
+      int fine = 0;
+      for (int i = 0; i < 100; ++i) {
+        const double u = r.uniform();
+        CPPUNIT_ASSERT( u*scale == std::floor(u*scale) );
+        fine += double(float(u)) != u;
+      }
+      CPPUNIT_ASSERT( fine > 90 );
+    }
+
+    // Chi-square test with 16 bins. 37.7 is the 0.999 quantile of the
+    // chi-square distribution with 15 degrees of freedom.
+    void testChiSquare()
+    {
+      RandomGenerator r(m_seed);
+      const int bins = 16, n = 160000;
+      std::vector<int> counts(bins, 0);
+      for (int i = 0; i < n; ++i) {
+        ++counts[int(r.uniform()*bins)];
+      }
+
+      const double e = double(n)/bins;
+      double chi2 = 0.;
+      for (int i = 0; i < bins; ++i) {
+        chi2 += (counts[i] - e)*(counts[i] - e)/e;
+      }
+      CPPUNIT_ASSERT( chi2 < 37.7 );
+    }
+
+    // Every bit of the 64-bit numbers is set in about half of them.
+    void testBits()
+    {
+      RandomGenerator r(m_seed);
+      const int n = 10000;
+      std::vector<int> ones(64, 0);
+      for (int i = 0; i < n; ++i) {
+        const uint64_t x = r();
+        for (int b = 0; b < 64; ++b) {
+          ones[b] += int((x >> b) & 1);
+        }
+      }
+      // The standard deviation of each count is 50.
+      for (int b = 0; b < 64; ++b) {
+        CPPUNIT_ASSERT( std::abs(ones[b] - n/2) < 300 );
+      }
+    }
+
+    void testSerialCorrelation()
+    {
+      RandomGenerator r(m_seed);
+      const int n = 100000;
+      double prev = r.uniform() - 0.5, sum = 0.;
+      for (int i = 0; i < n; ++i) {
+        const double u = r.uniform() - 0.5;
+        sum += prev*u;
+        prev = u;
+      }
+      // The correlation coefficient is 12*sum/n and has a standard
+      // deviation of about 0.003.
+      CPPUNIT_ASSERT( std::abs(12*sum/n) < 0.02 );
+    }
+
+    // The samples only depend on the seed, not on the number of threads.
+    void testSample()
+    {
+      Qubit q(0, 4);
+      q.apply(FixedGate::H(), 0).apply(FixedGate::H(), 1).apply(FixedGate::H(), 3);
+      const int shots = 2*c_parallel_threshold;
+
+      set_num_threads(1);
+      RandomGenerator r1(m_seed);
+      const std::vector<int> x1 = q.sample(shots, r1);
+      CPPUNIT_ASSERT( r1.counter() == 2*uint64_t(shots) );
+
+      for (int t = 2; t <= 4; ++t) {
+        set_num_threads(t);
+        RandomGenerator r(m_seed);
+        CPPUNIT_ASSERT( q.sample(shots, r) == x1 );
+        CPPUNIT_ASSERT( r.counter() == r1.counter() );
+      }
+
+      RandomGenerator r2(m_seed);
+      const std::map<int,int> counts = q.sampleCounts(shots, r2);
+      for (std::map<int,int>::const_iterator it = counts.begin();
+           it != counts.end(); ++it) {
+        CPPUNIT_ASSERT( (it->first & 2) == 0 );
+        CPPUNIT_ASSERT( std::abs(it->second - shots/8) < shots/40 );
+      }
+    }
+
+    void testMeasure()
+    {
+      Qubit q(0, 6);
+      for (int j = 0; j < 6; ++j) {
+        q.apply(FixedGate::H(), j);
+      }
+
+      RandomGenerator a(m_seed), b(m_seed);
+      for (int i = 0; i < 20; ++i) {
+        Qubit qa = q, qb = q;
+        qa.measure(a);
+        qb.measure(b);
+        CPPUNIT_ASSERT( qa.isApprox(qb) );
+
+        Qubit pa = q, pb = q;
+        pa.measurePartial(3, a);
+        pb.measurePartial(3, b);
+        CPPUNIT_ASSERT( pa.isApprox(pb) );
+      }
+      CPPUNIT_ASSERT( a.counter() == 40 );
+    }
+
+  private:
+    uint64_t m_seed;
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_RANDOMGENERATORTEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -0,0 +1,142 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_SIMDTEST_H
+#define QUCOSI_SIMDTEST_H
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/Simd>
+
+namespace QuCoSi {
+
+class SimdTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SimdTest);
+  CPPUNIT_TEST(testInsertZeroBits);
+  CPPUNIT_TEST(testOneQubit);
+  CPPUNIT_TEST(testTwoQubits);
+  CPPUNIT_TEST(testQubit);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testInsertZeroBits()
+    {
+      const int s[2] = { 1, 4 };
+      CPPUNIT_ASSERT( insert_zero_bits(0, s, 2) == 0 );
+      CPPUNIT_ASSERT( insert_zero_bits(1, s, 2) == 2 );
+      CPPUNIT_ASSERT( insert_zero_bits(2, s, 2) == 8 );
+      CPPUNIT_ASSERT( insert_zero_bits(7, s, 2) == 26 );
+      CPPUNIT_ASSERT( insert_zero_bits(7, s, 1) == 14 );
+    }
+
+    // Compares the SIMD kernel with the scalar kernel for every stride,
+    // including the strides inside and across SIMD registers.
+    void testOneQubit()
+    {
+      for (int n = 1; n <= 6; ++n) {
+        for (int j = 0; j < n; ++j) {
+          const int s = 1 << j;
+          field u[4];
+          Qubit a(1 << n), b;
+          a.randomize();
+          b = a;
+          random(u, 4);
+
+          apply_gate_scalar(a.data(), a.size(), &s, 1, u);
+          apply_gate_simd(b.data(), b.size(), &s, 1, u);
+          CPPUNIT_ASSERT( a.isApprox(b) );
+        }
+      }
+    }
+
+    void testTwoQubits()
+    {
+      for (int n = 2; n <= 6; ++n) {
+        for (int i = 0; i < n; ++i) {
+          for (int j = 0; j < n; ++j) {
+            if (i == j) {
+              continue;
+            }
+            const int s[2] = { 1 << i, 1 << j };
+            field u[16];
+            Qubit a(1 << n), b;
+            a.randomize();
+            b = a;
+            random(u, 16);
+
+            apply_gate_scalar(a.data(), a.size(), s, 2, u);
+            apply_gate_simd(b.data(), b.size(), s, 2, u);
+            CPPUNIT_ASSERT( a.isApprox(b) );
+          }
+        }
+      }
+    }
+
+    void testQubit()
+    {
+      const int n = 5;
+      Qubit q(1 << n), x;
+      q.randomize();
+      Gate g, h, u;
+      std::vector<int> t(2);
+
+      for (int j = 0; j < n; ++j) {
+        x = q;
+        CPPUNIT_ASSERT( x.apply(h.H(), j).isApprox(
+                          g.H().applyTo(j,n)*q) );
+      }
+      t[0] = 4;
+      t[1] = 0;
+      x = q;
+      CPPUNIT_ASSERT( x.apply(u.CNOT(), t).isApprox(
+                        g.C(0,4,n,h.X())*q) );
+      t[0] = 1;
+      t[1] = 2;
+      x = q;
+      CPPUNIT_ASSERT( x.apply(u.SWAP(), t).isApprox(
+                        g.SWAP().applyTo(1,n)*q) );
+    }
+
+  private:
+    void random(field* u, const int count)
+    {
+      for (int i = 0; i < count; ++i) {
+        u[i] = field(std::rand(), std::rand())/fptype(RAND_MAX);
+      }
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_SIMDTEST_H
+
+// vim: shiftwidth=2 textwidth=78
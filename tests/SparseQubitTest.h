@@ -0,0 +1,236 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_SPARSEQUBITTEST_H
+#define QUCOSI_SPARSEQUBITTEST_H
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Circuit>
+#include <QuCoSi/FixedGate>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/RandomGenerator>
+#include <QuCoSi/SparseQubit>
+
+namespace QuCoSi {
+
+class SparseQubitTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SparseQubitTest);
+  CPPUNIT_TEST(testBasisState);
+  CPPUNIT_TEST(testApply);
+  CPPUNIT_TEST(testPermutations);
+  CPPUNIT_TEST(testPrune);
+  CPPUNIT_TEST(testFillLimit);
+  CPPUNIT_TEST(testRun);
+  CPPUNIT_TEST(testSample);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testBasisState()
+    {
+      SparseQubit s(5, 4);
+      CPPUNIT_ASSERT( s.qubits() == 4 && s.size() == 16 );
+      CPPUNIT_ASSERT( s.count() == 1 && !s.isDense() );
+      CPPUNIT_ASSERT( s(5) == field(1) && s(4) == field(0) );
+      CPPUNIT_ASSERT( s.toQubit().isApprox(Qubit(5, 4)) );
+
+      Qubit q(16);
+      q.randomize();
+      q.normalize();
+      const SparseQubit d(q);
+      CPPUNIT_ASSERT( d.isDense() && d.count() == 16 );
+      CPPUNIT_ASSERT( d.toQubit().isApprox(q) );
+    }
+
+    // Sparse gates agree with the gates of a Qubit.
+    void testApply()
+    {
+      Gate g[7];
+      SparseQubit s(3, 5);
+      s.setFillLimit(1.);
+      Qubit q(3, 5);
+      std::vector<int> t(2), c(1, 4);
+      t[0] = 3;
+      t[1] = 0;
+      Matrix4c cnot;
+      cnot = g[6].CNOT();
+
+      s.apply(g[0].H(), 1).apply(g[1].Ry(0.4), 3).apply(g[2].CNOT(), 1);
+      s.apply(g[3].SWAP(), t).applyControlled(g[4].T(), 0, 2);
+      s.applyControlled(g[5].SWAP(), t, c, std::vector<int>(1, 0));
+      s.apply(FixedGate::Y(), 2).apply(cnot, 4, 1);
+      s.swapQubits(0, 4);
+      q.apply(g[0], 1).apply(g[1], 3).apply(g[2], 1);
+      q.apply(g[3], t).applyControlled(g[4], 0, 2);
+      q.applyControlled(g[5], t, c, std::vector<int>(1, 0));
+      q.apply(FixedGate::Y(), 2).apply(cnot, 4, 1);
+      q.swapQubits(0, 4);
+
+      CPPUNIT_ASSERT( !s.isDense() );
+      CPPUNIT_ASSERT( s.toQubit().isApprox(q) );
+    }
+
+    // Permutation gates never create more than one amplitude.
+    void testPermutations()
+    {
+      const int n = 24;
+      const int x = std::rand() % (1 << n);
+      SparseQubit s(x, n);
+      int y = x;
+      for (int k = 0; k < 100; ++k) {
+        const int a = std::rand() % n;
+        const int b = (a + 1 + std::rand() % (n-1)) % n;
+        const int ba = 1 << (n-1-a), bb = 1 << (n-1-b);
+        if (k % 2) {
+          Gate g;
+          s.applyControlled(g.X(), b, a);
+          if (y & ba) {
+            y ^= bb;
+          }
+        }
+        else {
+          s.swapQubits(a, b);
+          if (((y & ba) != 0) != ((y & bb) != 0)) {
+            y ^= ba | bb;
+          }
+        }
+      }
+      CPPUNIT_ASSERT( s.count() == 1 && s(y) == field(1) );
+
+      std::vector<int> f(1 << 10);
+      for (int i = 0; i < int(f.size()); ++i) {
+        f[i] = std::rand() % 4;
+      }
+      SparseQubit o(37, 12);
+      o.applyOracle(f, 2);
+      CPPUNIT_ASSERT( o.count() == 1 && o(37 ^ f[37/4]) == field(1) );
+    }
+
+    void testPrune()
+    {
+      Gate h;
+      SparseQubit s(0, 3);
+      s.apply(h.H(), 1);
+      CPPUNIT_ASSERT( s.count() == 2 );
+      s.apply(h, 1);
+      CPPUNIT_ASSERT( s.count() == 1 );
+      CPPUNIT_ASSERT( std::abs(s(0) - field(1)) < 1e-4 );
+
+      Gate r;
+      s.apply(r.Ry(1e-3), 0);
+      CPPUNIT_ASSERT( s.count() == 2 );
+      s.setThreshold(1e-2);
+      CPPUNIT_ASSERT( s.count() == 1 && s.threshold() == fptype(1e-2) );
+    }
+
+    // The state becomes dense above the fill limit and sparse again below
+    // half of it.
+    void testFillLimit()
+    {
+      const int n = 6;
+      SparseQubit s(0, n);
+      s.setFillLimit(0.25);
+      CPPUNIT_ASSERT( s.fillLimit() == fptype(0.25) );
+      Qubit q(0, n);
+      Gate h;
+      h.H();
+      for (int j = 0; j < n; ++j) {
+        s.apply(h, j);
+        q.apply(h, j);
+        CPPUNIT_ASSERT( s.isDense() == (j >= 4) );
+      }
+      CPPUNIT_ASSERT( s.count() == 64 && s.fill() == fptype(1) );
+      CPPUNIT_ASSERT( s.toQubit().isApprox(q) );
+
+      // Permutations with phases keep the count of a dense state.
+      Gate x, t, ti;
+      s.apply(x.X(), 2).apply(t.T(), 3);
+      q.apply(x, 2).apply(t, 3);
+      CPPUNIT_ASSERT( s.isDense() && s.count() == 64 );
+      CPPUNIT_ASSERT( s.toQubit().isApprox(q) );
+      ti = t.adjoint();
+      s.apply(ti, 3).apply(x, 2);
+      for (int j = 0; j < n; ++j) {
+        s.apply(h, j);
+      }
+      CPPUNIT_ASSERT( !s.isDense() && s.count() == 1 );
+      CPPUNIT_ASSERT( std::abs(s(0) - field(1)) < 1e-4 );
+    }
+
+    void testRun()
+    {
+      std::vector<int> f(16);
+      for (int i = 0; i < 16; ++i) {
+        f[i] = std::rand() % 2;
+      }
+      Circuit c(5);
+      c.X(0).CCNOT(0,1,2).H(3).Uf(f).CSWAP(3,0,4).Rz(0.3,4).qft(0,2);
+      c.T(1).CNOT(2,3);
+      SparseQubit s(6, 5);
+      s.run(c);
+      Qubit q(6, 5), x;
+      x = c*q;
+      CPPUNIT_ASSERT( s.toQubit().isApprox(x) );
+    }
+
+    void testSample()
+    {
+      const int n = 20;
+      Gate h, x;
+      h.H();
+      x.X();
+      SparseQubit s(0, n);
+      s.apply(h, 0);
+      for (int j = 1; j < n; ++j) {
+        s.applyControlled(x, j, j-1);
+      }
+      CPPUNIT_ASSERT( s.count() == 2 );
+
+      RandomGenerator rng(std::rand());
+      const std::vector<int> r = s.sample(100, rng);
+      int ones = 0;
+      for (int i = 0; i < int(r.size()); ++i) {
+        CPPUNIT_ASSERT( r[i] == 0 || r[i] == (1 << n)-1 );
+        ones += r[i] != 0;
+      }
+      CPPUNIT_ASSERT( ones > 10 && ones < 90 );
+
+      s.measure(rng);
+      CPPUNIT_ASSERT( s.count() == 1 );
+      CPPUNIT_ASSERT( s(0) == field(1) || s((1 << n)-1) == field(1) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_SPARSEQUBITTEST_H
+
+// vim: shiftwidth=2 textwidth=78
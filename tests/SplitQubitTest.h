@@ -0,0 +1,140 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_SPLITQUBITTEST_H
+#define QUCOSI_SPLITQUBITTEST_H
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/SplitQubit>
+
+namespace QuCoSi {
+
+class SplitQubitTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SplitQubitTest);
+  CPPUNIT_TEST(testConversion);
+  CPPUNIT_TEST(testOneQubit);
+  CPPUNIT_TEST(testTwoQubits);
+  CPPUNIT_TEST(testThreeQubits);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testConversion()
+    {
+      Qubit q(16);
+      q.randomize();
+      SplitQubit s(q);
+
+      CPPUNIT_ASSERT( s.size() == 16 );
+      CPPUNIT_ASSERT( s(5) == q(5) );
+      CPPUNIT_ASSERT( s.real()(3) == q(3).real() );
+      CPPUNIT_ASSERT( s.imag()(3) == q(3).imag() );
+      CPPUNIT_ASSERT( s.toQubit() == q );
+      CPPUNIT_ASSERT( SplitQubit(4).toQubit().isZero() );
+    }
+
+    void testOneQubit()
+    {
+      const int n = 12;
+      Qubit q(1 << n);
+      q.randomize();
+      Gate g[4];
+      g[0].H();
+      g[1].Ry(0.3);
+      g[2].T();
+      g[3].Rx(1.1);
+
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < n; ++j) {
+          SplitQubit s(q);
+          Qubit x = q;
+          s.apply(g[i], j);
+          x.apply(g[i], j);
+          CPPUNIT_ASSERT( s.toQubit().isApprox(x) );
+        }
+      }
+    }
+
+    void testTwoQubits()
+    {
+      const int n = 6;
+      Qubit q(1 << n);
+      q.randomize();
+      Gate g[3];
+      g[0].CNOT();
+      g[1].C(1,0,2,g[2].P());
+      g[2].setRandom(4,4);
+      std::vector<int> t(2);
+
+      for (int i = 0; i < 3; ++i) {
+        for (t[0] = 0; t[0] < n; ++t[0]) {
+          for (t[1] = 0; t[1] < n; ++t[1]) {
+            if (t[0] == t[1]) {
+              continue;
+            }
+            SplitQubit s(q);
+            Qubit x = q;
+            s.apply(g[i], t);
+            x.apply(g[i], t);
+            CPPUNIT_ASSERT( s.toQubit().isApprox(x) );
+          }
+        }
+      }
+    }
+
+    void testThreeQubits()
+    {
+      const int n = 5;
+      Qubit q(1 << n);
+      q.randomize();
+      Gate g;
+      std::vector<int> t(3);
+      t[0] = 3;
+      t[1] = 0;
+      t[2] = 2;
+
+      SplitQubit s(q);
+      Qubit x = q;
+      s.apply(g.CCNOT(), t);
+      x.apply(g, t);
+      CPPUNIT_ASSERT( s.toQubit().isApprox(x) );
+
+      s.apply(g.CSWAP(), 1);
+      x.apply(g, 1);
+      CPPUNIT_ASSERT( s.toQubit().isApprox(x) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_SPLITQUBITTEST_H
+
+// vim: shiftwidth=2 textwidth=78
@@ -0,0 +1,238 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_STABILIZERSTATETEST_H
+#define QUCOSI_STABILIZERSTATETEST_H
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Circuit>
+#include <QuCoSi/Gate>
+#include <QuCoSi/PauliString>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/RandomGenerator>
+#include <QuCoSi/StabilizerState>
+
+namespace QuCoSi {
+
+class StabilizerStateTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(StabilizerStateTest);
+  CPPUNIT_TEST(testInitial);
+  CPPUNIT_TEST(testRandomCircuits);
+  CPPUNIT_TEST(testMeasure);
+  CPPUNIT_TEST(testGhz);
+  CPPUNIT_TEST(testBernsteinVazirani);
+  CPPUNIT_TEST(testIsClifford);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testInitial()
+    {
+      StabilizerState s(3);
+      CPPUNIT_ASSERT( s.qubits() == 3 );
+      CPPUNIT_ASSERT( s.stabilizer(0) == "+ZII" );
+      CPPUNIT_ASSERT( s.stabilizer(2) == "+IIZ" );
+      s.H(0).CNOT(0,1).X(2);
+      CPPUNIT_ASSERT( s.probabilityOne(0) == fptype(0.5) );
+      CPPUNIT_ASSERT( s.probabilityOne(2) == fptype(1) );
+    }
+
+    // The stabilizers of random Clifford circuits stabilize the state the
+    // same circuit prepares on a Qubit.
+    void testRandomCircuits()
+    {
+      const int n = 4;
+      for (int k = 0; k < 20; ++k) {
+        const Circuit c = randomCircuit(n, 40);
+        CPPUNIT_ASSERT( c.isClifford() );
+        StabilizerState s(n);
+        s.run(c);
+        Qubit q(0, n), x;
+        x = c*q;
+        CPPUNIT_ASSERT( isStabilized(s, x) );
+
+        for (int j = 0; j < n; ++j) {
+          const fptype p = x.marginalProbabilities(std::vector<int>(1, j))[1];
+          CPPUNIT_ASSERT( std::abs(s.probabilityOne(j) - p) < 1e-4 );
+        }
+      }
+    }
+
+    // Measurements collapse the state like projections of a Qubit.
+    void testMeasure()
+    {
+      const int n = 5;
+      RandomGenerator rng(std::rand());
+      for (int k = 0; k < 10; ++k) {
+        const Circuit c = randomCircuit(n, 50);
+        StabilizerState s(n);
+        s.run(c);
+        Qubit q(0, n), x;
+        x = c*q;
+        for (int j = 0; j < n; ++j) {
+          const int m = s.measure(j, rng);
+          const int b = 1 << (n-1-j);
+          for (int i = 0; i < x.size(); ++i) {
+            if (((i & b) != 0) != (m != 0)) {
+              x(i) = 0;
+            }
+          }
+          CPPUNIT_ASSERT( x.norm() > 1e-3 );
+          x.normalize();
+          CPPUNIT_ASSERT( isStabilized(s, x) );
+        }
+      }
+    }
+
+    void testGhz()
+    {
+      const int n = 300;
+      StabilizerState s(n);
+      s.H(0);
+      for (int j = 1; j < n; ++j) {
+        s.CNOT(j-1, j);
+      }
+      RandomGenerator rng(std::rand());
+      const std::vector< std::vector<int> > r = s.sample(20, rng);
+      int ones = 0;
+      for (int k = 0; k < int(r.size()); ++k) {
+        CPPUNIT_ASSERT( int(r[k].size()) == n );
+        for (int j = 1; j < n; ++j) {
+          CPPUNIT_ASSERT( r[k][j] == r[k][0] );
+        }
+        ones += r[k][0];
+      }
+      CPPUNIT_ASSERT( ones > 0 && ones < 20 );
+
+      // Sampling does not change the state.
+      CPPUNIT_ASSERT( s.probabilityOne(n-1) == fptype(0.5) );
+      const int m = s.measure(n/2, rng);
+      CPPUNIT_ASSERT( s.probabilityOne(0) == fptype(m) );
+      CPPUNIT_ASSERT( s.probabilityOne(n-1) == fptype(m) );
+    }
+
+    void testBernsteinVazirani()
+    {
+      const int n = 200;
+      std::vector<int> a(n);
+      Circuit c(n+1);
+      c.X(n).H(n);
+      for (int j = 0; j < n; ++j) {
+        a[j] = std::rand() % 2;
+        c.H(j);
+      }
+      for (int j = 0; j < n; ++j) {
+        if (a[j]) {
+          c.CNOT(j, n);
+        }
+      }
+      for (int j = 0; j < n; ++j) {
+        c.H(j);
+      }
+
+      StabilizerState s(n+1);
+      s.run(c);
+      RandomGenerator rng(std::rand());
+      const std::vector<int> m = s.measureAll(rng);
+      for (int j = 0; j < n; ++j) {
+        CPPUNIT_ASSERT( m[j] == a[j] );
+      }
+    }
+
+    void testIsClifford()
+    {
+      Circuit c(3);
+      c.I(0).X(1).Y(2).Z(0).H(1).P(2).SWAP(0,2).CNOT(1,0);
+      CPPUNIT_ASSERT( c.isClifford() );
+      CPPUNIT_ASSERT( Circuit(2).isClifford() );
+      Circuit d = c;
+      CPPUNIT_ASSERT( !d.T(0).isClifford() );
+      d = c;
+      CPPUNIT_ASSERT( !d.CCNOT(0,1,2).isClifford() );
+      d = c;
+      CPPUNIT_ASSERT( !d.Rx(0.5,1).isClifford() );
+      d = c;
+      CPPUNIT_ASSERT( !d.qft(0,2).isClifford() );
+    }
+
+  private:
+    // Returns a random circuit of Clifford operations, including
+    // controlled Y and Z gates and controls on |0>.
+    static Circuit randomCircuit(const int n, const int size)
+    {
+      Circuit c(n);
+      for (int k = 0; k < size; ++k) {
+        const int a = std::rand() % n;
+        const int b = (a + 1 + std::rand() % (n-1)) % n;
+        switch (std::rand() % 9) {
+          case 0: c.X(a); break;
+          case 1: c.Y(a); break;
+          case 2: c.Z(a); break;
+          case 3: c.H(a); break;
+          case 4: c.P(a); break;
+          case 5: c.SWAP(a, b); break;
+          case 6: c.CNOT(a, b); break;
+          default: {
+            Circuit::Operation op;
+            Gate g;
+            const bool z = std::rand() % 2;
+            op.name = z ? "Z" : "Y";
+            op.gate = z ? g.Z() : g.Y();
+            op.targets.push_back(b);
+            op.controls.push_back(a);
+            op.values.push_back(std::rand() % 2);
+            c.append(op);
+          }
+        }
+      }
+      return c;
+    }
+
+    // Checks that every stabilizer of s has the expectation value 1 in q.
+    static bool isStabilized(const StabilizerState& s, const Qubit& q)
+    {
+      for (int i = 0; i < s.qubits(); ++i) {
+        const std::string t = s.stabilizer(i);
+        const PauliString p(t.substr(1), t[0] == '-' ? -1 : 1);
+        if (std::abs(p.expectation(q) - 1) > 1e-4) {
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_STABILIZERSTATETEST_H
+
+// vim: shiftwidth=2 textwidth=78
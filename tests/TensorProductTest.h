@@ -0,0 +1,130 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef QUCOSI_TENSORPRODUCTTEST_H
+#define QUCOSI_TENSORPRODUCTTEST_H
+
+#include <cstdlib>
+#include <ctime>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <QuCoSi/Gate>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/TensorProduct>
+
+namespace QuCoSi {
+
+class TensorProductTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TensorProductTest);
+  CPPUNIT_TEST(testToGate);
+  CPPUNIT_TEST(testQubit);
+  CPPUNIT_TEST(testProduct);
+  CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void setUp()
+    {
+      std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
+    }
+
+    void tearDown() {}
+
+    void testToGate()
+    {
+      Gate h, x, c;
+      h.H();
+      x.X();
+      c.CNOT();
+
+      TensorProduct t(h);
+      CPPUNIT_ASSERT( t.tensorPow(3).toGate().isApprox(h.tensorPow(3)) );
+      CPPUNIT_ASSERT( t.tensorPow(3).qubits() == 3 );
+      CPPUNIT_ASSERT( t.tensorPow(3).factors() == 3 );
+
+      t.tensorDotSet(c).tensorDotSet(x);
+      CPPUNIT_ASSERT( t.toGate().isApprox(
+                        h.tensorDot(c).tensorDot(x)) );
+      CPPUNIT_ASSERT( t.qubits() == 4 );
+
+      CPPUNIT_ASSERT( TensorProduct(c).applyTo(1,4).toGate() ==
+                      c.applyTo(1,4) );
+      CPPUNIT_ASSERT( TensorProduct(c).applyTo(1,4).factors() == 3 );
+    }
+
+    void testQubit()
+    {
+      Gate h, r, c;
+      h.H();
+      r.Ry(1.1);
+      c.CNOT();
+
+      Qubit q(64), x, y;
+      q.randomize();
+
+      TensorProduct t = TensorProduct(h).tensorPow(6);
+      x = t*q;
+      y = h.tensorPow(6)*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+
+      t = TensorProduct(r).tensorDot(c).tensorDot(TensorProduct(h)
+            .applyTo(1,3));
+      x = q;
+      t.transform(x);
+      y = t.toGate()*q;
+      CPPUNIT_ASSERT( x.isApprox(y) );
+    }
+
+    void testProduct()
+    {
+      Gate h, r, c, s;
+      h.H();
+      r.Rx(0.3);
+      c.CNOT();
+      s.SWAP();
+
+      // Factors that line up are multiplied factor by factor.
+      TensorProduct a = TensorProduct(h).tensorDot(c);
+      TensorProduct b = TensorProduct(r).tensorDot(s);
+      CPPUNIT_ASSERT( (a*b).factors() == 2 );
+      CPPUNIT_ASSERT( (a*b).toGate().isApprox(a.toGate()*b.toGate()) );
+
+      // Factors that do not line up are merged.
+      b = TensorProduct(s).tensorDot(r);
+      CPPUNIT_ASSERT( (a*b).factors() == 1 );
+      CPPUNIT_ASSERT( (a*b).toGate().isApprox(a.toGate()*b.toGate()) );
+
+      // Identities only pass the other factors through.
+      a = TensorProduct(c).applyTo(0,5);
+      b = TensorProduct(h).applyTo(3,5);
+      CPPUNIT_ASSERT( (a*b).factors() == 4 );
+      CPPUNIT_ASSERT( (a*b).toGate().isApprox(a.toGate()*b.toGate()) );
+      CPPUNIT_ASSERT( (b*a).toGate().isApprox(b.toGate()*a.toGate()) );
+
+      a = TensorProduct(c).applyTo(1,5);
+      b = TensorProduct(r).tensorPow(5);
+      CPPUNIT_ASSERT( (a*b).toGate().isApprox(a.toGate()*b.toGate()) );
+      CPPUNIT_ASSERT( (b*a).toGate().isApprox(b.toGate()*a.toGate()) );
+    }
+};
+
+} // namespace QuCoSi
+
+#endif // QUCOSI_TENSORPRODUCTTEST_H
+
+// vim: shiftwidth=2 textwidth=78
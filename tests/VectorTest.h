@@ -19,6 +19,7 @@
 
 #include <cstdlib>
 #include <ctime>
+#include <limits>
 
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -31,6 +32,7 @@ class VectorTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(VectorTest);
   CPPUNIT_TEST(testLog2);
+  CPPUNIT_TEST(testTolerance);
   CPPUNIT_TEST(testIsNormalized);
   CPPUNIT_TEST(testRandomize);
   CPPUNIT_TEST(testTensorDot);
@@ -59,6 +61,32 @@ class VectorTest : public CppUnit::TestFixture
       CPPUNIT_ASSERT( log2(256) == 8 );
     }
 
+    void testTolerance()
+    {
+      const fptype eps = std::numeric_limits<fptype>::epsilon();
+      CPPUNIT_ASSERT( sizeof(field) == 2*sizeof(fptype) );
+      CPPUNIT_ASSERT( c_tolerance == eps );
+      CPPUNIT_ASSERT( is_zero(0) );
+      CPPUNIT_ASSERT( is_zero(-eps) );
+      CPPUNIT_ASSERT( !is_zero(4*eps) );
+      CPPUNIT_ASSERT( is_one(1+eps/2) );
+      CPPUNIT_ASSERT( !is_one(1+4*eps) );
+
+      // A rounding error of single precision is not negligible in double
+      // precision.
+      const fptype third = fptype(float(1)/3);
+      CPPUNIT_ASSERT( is_one(3*third) == (sizeof(fptype) == sizeof(float)) );
+
+      // The tolerance is the one of the type of the argument.
+      const float f = float(1)/3;
+      CPPUNIT_ASSERT( is_one(3*f) && !is_one(3*double(f)) );
+      BasicVector<float> v(1, 0);
+      BasicVector<double> w(1, 0);
+      v(0) += std::numeric_limits<float>::epsilon()/2;
+      w(0) += std::numeric_limits<float>::epsilon()/2;
+      CPPUNIT_ASSERT( v.isNormalized() && !w.isNormalized() );
+    }
+
     void testIsNormalized()
     {
       Vector v1(field(1,0), field(0,0)),
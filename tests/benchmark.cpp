@@ -0,0 +1,143 @@
+// QuCoSi - Quantum Computer Simulation
+// Copyright © 2009 Frank S. Thomas <f.thomas@gmx.de>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the scalar and the SIMD kernels for one- and two-qubit gates and
+// the interleaved Qubit with the split layout of SplitQubit. All kernels run
+// on a single thread, so the speedups only show the effect of SIMD and of
+// the memory layout, and the times are wall-clock times.
+// Usage: benchmark [qubits] [repetitions]
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include <QuCoSi/Aux>
+#include <QuCoSi/Gate>
+#include <QuCoSi/Parallel>
+#include <QuCoSi/Qubit>
+#include <QuCoSi/Simd>
+#include <QuCoSi/SplitQubit>
+
+using namespace std;
+using namespace QuCoSi;
+
+typedef void (*Kernel)(field*, const int, const int*, const int,
+                       const field*);
+
+// Returns the wall-clock time in seconds. Unlike clock() this does not add
+// up the CPU time of all threads.
+double wall_time()
+{
+#ifdef _OPENMP
+  return omp_get_wtime();
+#else
+  timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + 1e-6*t.tv_usec;
+#endif
+}
+
+// Returns the time in seconds that kernel needs to apply u to each
+// of the n qubits (k == 1) or every pair of neighbouring qubits (k == 2)
+// of q.
+double run(Kernel kernel, Qubit& q, const int n, const int k,
+           const field* u, const int repetitions)
+{
+  const double start = wall_time();
+  for (int r = 0; r < repetitions; ++r) {
+    for (int j = 0; j+k <= n; ++j) {
+      const int s[2] = { 1 << j, 1 << (j+1) };
+      kernel(q.data(), q.size(), s, k, u);
+    }
+  }
+  return wall_time()-start;
+}
+
+// Returns the time in seconds that q.apply() needs to apply u to each of
+// the n qubits.
+template <typename State>
+double run(State& q, const int n, const Gate& u, const int repetitions)
+{
+  const double start = wall_time();
+  for (int r = 0; r < repetitions; ++r) {
+    for (int j = 0; j < n; ++j) {
+      q.apply(u, j);
+    }
+  }
+  return wall_time()-start;
+}
+
+int main(int argc, char* argv[])
+{
+  const int n = argc > 1 ? atoi(argv[1]) : 20;
+  const int repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+  // The gates H and H ⊗ T in row-major order. Both are unitary, so that
+  // the amplitudes neither grow nor decay into denormal numbers.
+  Gate a, b, ht = a.H().tensorDot(b.T());
+  field h[4], u[16];
+  for (int i = 0; i < 16; ++i) {
+    u[i] = ht(i/4, i%4);
+  }
+  for (int i = 0; i < 4; ++i) {
+    h[i] = a(i/2, i%2);
+  }
+
+  Qubit q(1 << n);
+  q.randomize();
+  set_num_threads(1);
+
+#ifdef QUCOSI_SIMD
+  cout << "SIMD lanes: " << SimdOps<fptype>::lanes
+       << (sizeof(fptype) == sizeof(float) ? " (float)" : " (double)")
+       << endl;
+#else
+  cout << "SIMD lanes: none (scalar fallback)" << endl;
+#endif
+  cout << "qubits: " << n << ", repetitions: " << repetitions
+       << ", threads: 1 (wall-clock time)" << endl;
+
+  for (int k = 1; k <= 2; ++k) {
+    const field* g = k == 1 ? h : u;
+    const double scalar = run(apply_gate_scalar, q, n, k, g, repetitions);
+    const double simd = run(apply_gate_simd, q, n, k, g, repetitions);
+    cout << k << "-qubit gate: scalar " << fixed << setprecision(3)
+         << scalar << " s, simd " << simd << " s, speedup "
+         << setprecision(2) << scalar/simd << endl;
+  }
+
+  Gate g[2];
+  g[0].H();
+  g[1].T();
+  SplitQubit s(q);
+  for (int i = 0; i < 2; ++i) {
+    const double interleaved = run(q, n, g[i], repetitions);
+    const double split = run(s, n, g[i], repetitions);
+    cout << (i == 0 ? "H" : "T") << " gate: Qubit " << setprecision(3)
+         << interleaved << " s, SplitQubit " << split << " s, speedup "
+         << setprecision(2) << interleaved/split << endl;
+  }
+
+  return 0;
+}
+
+// vim: shiftwidth=2 textwidth=78
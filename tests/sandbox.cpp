@@ -17,9 +17,11 @@
 #include <bitset>
 #include <cstdlib>
 #include <ctime>
+#include <iostream>
 #include <limits>
 
 #include <QuCoSi/Aux>
+#include <QuCoSi/FixedGate>
 #include <QuCoSi/Gate>
 #include <QuCoSi/Qubit>
 #include <QuCoSi/Vector>
@@ -32,10 +34,21 @@ int main(int, char *[])
 {
   std::srand((unsigned)std::time(NULL) + (unsigned)std::clock());
 
+  clock_t start = clock();
   Gate x;
   for(int i = 0; i < 5000000; i++) {
     x.CNOT();
   }
+  cout << "Gate::CNOT():      " << double(clock()-start)/CLOCKS_PER_SEC
+       << " s" << endl;
+
+  start = clock();
+  Matrix4c y;
+  for(int i = 0; i < 5000000; i++) {
+    y = FixedGate::CNOT();
+  }
+  cout << "FixedGate::CNOT(): " << double(clock()-start)/CLOCKS_PER_SEC
+       << " s" << endl;
 
 /*
   Gate u;
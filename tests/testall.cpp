@@ -17,8 +17,24 @@
 #include <cppunit/ui/text/TestRunner.h>
 
 #include <AlgorithmsTest.h>
+#include <AliasTableTest.h>
+#include <CircuitTest.h>
+#include <DensityMatrixTest.h>
+#include <DiagonalGateTest.h>
+#include <FixedGateTest.h>
 #include <GateTest.h>
+#include <MatrixProductStateTest.h>
+#include <NoiseModelTest.h>
+#include <ParallelTest.h>
+#include <PauliStringTest.h>
+#include <PermutationGateTest.h>
 #include <QubitTest.h>
+#include <RandomGeneratorTest.h>
+#include <SimdTest.h>
+#include <SparseQubitTest.h>
+#include <SplitQubitTest.h>
+#include <StabilizerStateTest.h>
+#include <TensorProductTest.h>
 #include <VectorTest.h>
 
 int main(int argc, char* argv[])
@@ -27,8 +43,24 @@ int main(int argc, char* argv[])
 
   runner.addTest(QuCoSi::VectorTest::suite());
   runner.addTest(QuCoSi::QubitTest::suite());
+  runner.addTest(QuCoSi::AliasTableTest::suite());
+  runner.addTest(QuCoSi::RandomGeneratorTest::suite());
+  runner.addTest(QuCoSi::SparseQubitTest::suite());
+  runner.addTest(QuCoSi::SplitQubitTest::suite());
+  runner.addTest(QuCoSi::MatrixProductStateTest::suite());
+  runner.addTest(QuCoSi::StabilizerStateTest::suite());
+  runner.addTest(QuCoSi::DensityMatrixTest::suite());
+  runner.addTest(QuCoSi::NoiseModelTest::suite());
   runner.addTest(QuCoSi::GateTest::suite());
+  runner.addTest(QuCoSi::FixedGateTest::suite());
+  runner.addTest(QuCoSi::PermutationGateTest::suite());
+  runner.addTest(QuCoSi::DiagonalGateTest::suite());
+  runner.addTest(QuCoSi::PauliStringTest::suite());
+  runner.addTest(QuCoSi::TensorProductTest::suite());
+  runner.addTest(QuCoSi::CircuitTest::suite());
   runner.addTest(QuCoSi::AlgorithmsTest::suite());
+  runner.addTest(QuCoSi::ParallelTest::suite());
+  runner.addTest(QuCoSi::SimdTest::suite());
   runner.run();
 
   return 0;